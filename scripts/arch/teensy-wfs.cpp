@@ -0,0 +1,698 @@
+/************************************************************************
+ IMPORTANT NOTE : this file contains two clearly delimited sections :
+ the ARCHITECTURE section (in two parts) and the USER section. Each section
+ is governed by its own copyright and license. Please check individually
+ each section for license and copyright information.
+ *************************************************************************/
+
+/*******************BEGIN ARCHITECTURE SECTION (part 1/2)****************/
+
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2019-2020 GRAME, Centre National de Creation Musicale &
+ Aalborg University (Copenhagen, Denmark)
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+
+ ************************************************************************
+ ************************************************************************/
+
+/*
+ * Project-specific variant of Faust's teensy.cpp, for the WFS DSP: see
+ * scripts/f2t.sh. In place of the stock architecture's MapUI, MIDI and
+ * polyphony support, the generated DSP is given just enough of Faust's dsp,
+ * Meta and UI interfaces to compile, and its parameters are gathered into a
+ * fixed-size ParamTable.
+ */
+
+#include <string.h> // for memset
+
+#include "WFS.h"
+
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT float
+#endif
+
+/**
+ * Base class of the generated DSP. WFS holds the DSP by its concrete type, so
+ * nothing is dispatched through this.
+ */
+class dsp {
+    public:
+        virtual ~dsp() {}
+};
+
+struct Meta {
+    void declare(const char* key, const char* value) {}
+};
+
+// The generated DSP's buildUserInterface() fills in a ParamTable directly.
+typedef ParamTable UI;
+
+// we require macro declarations
+#define FAUST_UIMACROS
+
+// but we will ignore most of them
+#define FAUST_ADDBUTTON(l,f)
+#define FAUST_ADDCHECKBOX(l,f)
+#define FAUST_ADDVERTICALSLIDER(l,f,i,a,b,s)
+#define FAUST_ADDHORIZONTALSLIDER(l,f,i,a,b,s)
+#define FAUST_ADDNUMENTRY(l,f,i,a,b,s)
+#define FAUST_ADDVERTICALBARGRAPH(l,f,a,b)
+#define FAUST_ADDHORIZONTALBARGRAPH(l,f,a,b)
+
+/******************************************************************************
+ *******************************************************************************
+
+ VECTOR INTRINSICS
+
+ *******************************************************************************
+ *******************************************************************************/
+
+<<includeIntrinsic>>
+
+/********************END ARCHITECTURE SECTION (part 1/2)****************/
+
+/**************************BEGIN USER SECTION **************************/
+
+<<includeclass>>
+
+/***************************END USER SECTION ***************************/
+
+/*******************BEGIN ARCHITECTURE SECTION (part 2/2)***************/
+
+#define MULT_16 32767
+#define DIV_16 0.0000305185
+
+unsigned __exidx_start;
+unsigned __exidx_end;
+
+#include "WFSRenderer.h"
+#include "FlushToZero.h"
+#include "Arena.h"
+#include "../Log.h"
+#ifdef WFS_SELF_CHECK
+#include "RenderCheck.h"
+#include <new>
+#endif
+
+static_assert(FAUST_INPUTS == NUM_SOURCES, "NUM_SOURCES must match the Faust DSP's inputs");
+static_assert(FAUST_OUTPUTS == SPEAKERS_PER_MODULE, "SPEAKERS_PER_MODULE must match the Faust DSP's outputs");
+
+// Stands in for input blocks that haven't arrived.
+static const int16_t kSilence[AUDIO_BLOCK_SAMPLES] = {0};
+
+#ifdef WFS_REFERENCE_DSP
+
+/**
+ * The Faust-generated DSP, closed to further overriding so that calls through
+ * a wfs_reference_dsp pointer needn't go through its vtable.
+ */
+class wfs_reference_dsp final : public mydsp {};
+
+#else
+
+static_assert(AUDIO_SAMPLE_RATE_EXACT <= MAX_SAMPLE_RATE, "Raise MAX_SAMPLE_RATE to at least AUDIO_SAMPLE_RATE_EXACT");
+
+/**
+ * Presents the hand-written WFSRenderer in the manner of a Faust DSP, with the
+ * same parameter labels. Build with WFS_REFERENCE_DSP defined to use the
+ * Faust-generated mydsp instead.
+ */
+class wfs_renderer_dsp final {
+
+    private:
+
+        WFSRenderer fRenderer;
+
+    public:
+
+        void metadata(Meta* m) { m->declare("name", "Distributed WFS"); }
+
+        int getNumInputs() { return WFSRenderer::kNumSources; }
+        int getNumOutputs() { return WFSRenderer::kNumSpeakers; }
+
+        void buildUserInterface(UI* ui_interface)
+        {
+            char label[16];
+            ui_interface->openVerticalBox("Distributed WFS");
+            for (int i = 0; i < WFSRenderer::kNumSources; i++) {
+                snprintf(label, sizeof(label), "%d/x", i);
+                ui_interface->addHorizontalSlider(label, fRenderer.getSourceXZone(i), FAUSTFLOAT(0.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(1.0f), FAUSTFLOAT(0.001f));
+                snprintf(label, sizeof(label), "%d/y", i);
+                ui_interface->addHorizontalSlider(label, fRenderer.getSourceYZone(i), FAUSTFLOAT(0.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(1.0f), FAUSTFLOAT(0.001f));
+                snprintf(label, sizeof(label), "%d/gain", i);
+                ui_interface->addHorizontalSlider(label, fRenderer.getSourceGainZone(i), FAUSTFLOAT(1.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(2.0f), FAUSTFLOAT(0.001f));
+                snprintf(label, sizeof(label), "%d/mute", i);
+                ui_interface->addCheckButton(label, fRenderer.getSourceMuteZone(i));
+            }
+            ui_interface->addCheckButton("antiAlias", fRenderer.getAntiAliasZone());
+            ui_interface->addCheckButton("sharedFilter", fRenderer.getSharedFilterZone());
+            ui_interface->addCheckButton("subband", fRenderer.getSubbandZone());
+            ui_interface->addHorizontalSlider("lodDistance", fRenderer.getLODDistanceZone(), FAUSTFLOAT(0.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(MAX_Y_DIST), FAUSTFLOAT(0.01f));
+            ui_interface->addHorizontalSlider("lodCrossfade", fRenderer.getLODCrossfadeZone(), FAUSTFLOAT(1.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(MAX_Y_DIST), FAUSTFLOAT(0.01f));
+            ui_interface->addHorizontalSlider("moduleID", fRenderer.getModuleIDZone(), FAUSTFLOAT(0.0f), FAUSTFLOAT(0.0f), FAUSTFLOAT(NUM_SPEAKERS / SPEAKERS_PER_MODULE - 1), FAUSTFLOAT(1.0f));
+            ui_interface->closeBox();
+        }
+
+        int getSampleRate() { return fRenderer.getSampleRate(); }
+
+        void init(int sample_rate) { instanceInit(sample_rate); }
+        void instanceInit(int sample_rate) { fRenderer.init(sample_rate); }
+        void instanceConstants(int sample_rate) { fRenderer.init(sample_rate); }
+        void instanceResetUserInterface() {}
+        void instanceClear() { fRenderer.clear(); }
+
+        void compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs)
+        {
+            fRenderer.compute(count, inputs, outputs);
+        }
+
+        // Takes the audio library's samples as they are.
+        void compute(int count, const int16_t* const* inputs, FAUSTFLOAT** outputs)
+        {
+            fRenderer.compute(count, inputs, outputs);
+        }
+
+        WFSRenderer& getRenderer() { return fRenderer; }
+
+};
+#endif
+
+// Everything the DSP reads and writes per block, sized exactly, and placed
+// according to WFS_ARENA_DMAMEM/WFS_ARENA_EXTMEM; see Arena.h. DMAMEM and
+// EXTMEM aren't zeroed at startup, so everything in the arena is constructed
+// in place.
+static constexpr size_t kArenaSize = Arena::footprint(sizeof(wfs_dsp))
+#ifdef WFS_REFERENCE_DSP
+    + Arena::footprint(FAUST_INPUTS * AUDIO_BLOCK_SAMPLES * sizeof(float))
+#endif
+    + Arena::footprint(FAUST_OUTPUTS * AUDIO_BLOCK_SAMPLES * sizeof(float));
+
+WFS_ARENA_SECTION static uint8_t wfsArenaMemory[kArenaSize] __attribute__((aligned(Arena::kAlignment)));
+
+WFS::WFS() : AudioStream(FAUST_INPUTS, fInputQueue), fArena(wfsArenaMemory, kArenaSize, WFS_ARENA_REGION), fRenderer(NULL)
+{
+    fDSP = fArena.create<wfs_dsp>("dsp");
+#ifndef WFS_REFERENCE_DSP
+    fRenderer = &fDSP->getRenderer();
+#endif
+
+    fDSP->init(AUDIO_SAMPLE_RATE_EXACT);
+    fDSP->buildUserInterface(&fParams);
+
+    char label[ParamTable::kMaxLabelLength];
+    for (int i = 0; i < FAUST_INPUTS; i++) {
+        snprintf(label, sizeof(label), "%d/x", i);
+        fSourceXZone[i] = fParams.getZone(fParams.getIndex(label));
+        snprintf(label, sizeof(label), "%d/y", i);
+        fSourceYZone[i] = fParams.getZone(fParams.getIndex(label));
+    }
+    fModuleIDZone = fParams.getZone(fParams.getIndex("moduleID"));
+
+    for (int i = 0; i < FAUST_INPUTS; i++) {
+        fStagedX[i] = *fSourceXZone[i];
+        fStagedY[i] = *fSourceYZone[i];
+        fStagedWhen[i] = 0;
+        fStaged[i] = false;
+    }
+    fNumScheduled = 0;
+    fPositionsCommitted = 0;
+    fPositionOverflows = 0;
+    fPositionsApplied = 0;
+    fPositionsLate = 0;
+    fPositionsEarly = 0;
+    fBlockTime = 0;
+    fBlockCycles = 0;
+
+#ifdef WFS_REFERENCE_DSP
+    float* inBuffer = fArena.createArray<float>(FAUST_INPUTS * AUDIO_BLOCK_SAMPLES, "input buffers");
+    for (int i = 0; i < FAUST_INPUTS; i++) {
+        fInChannel[i] = inBuffer + i * AUDIO_BLOCK_SAMPLES;
+    }
+#endif
+
+    // Output scaling, with any edge taper folded in; see setModuleID().
+    float* outBuffer = fArena.createArray<float>(FAUST_OUTPUTS * AUDIO_BLOCK_SAMPLES, "output buffers");
+    for (int i = 0; i < FAUST_OUTPUTS; i++) {
+        fOutChannel[i] = outBuffer + i * AUDIO_BLOCK_SAMPLES;
+        fOutputGain[i] = MULT_16 * computeTaper(i);
+        fAllocationFailures[i] = 0;
+    }
+
+    resetProfileMax();
+    fFlushToZero = true;
+#ifdef WFS_COUNT_DENORMALS
+    fDenormalBlocks = 0;
+#endif
+}
+
+WFS::~WFS()
+{
+    fDSP->~wfs_dsp();
+}
+
+template <int INPUTS, int OUTPUTS>
+void WFS::updateImp(void)
+{
+    uint32_t start = ARM_DWT_CYCCNT;
+    uint64_t blockTime = fBlockTime;
+    fBlockCycles = start;
+
+    if (fFlushToZero) {
+        wfs::enableFlushToZero();
+    }
+
+    // Apply position changes whole, at the block boundary, unless they're
+    // scheduled for later.
+    PositionUpdate position;
+    while (fPositionQueue.pop(position)) {
+        if (position.when > blockTime) {
+            if (fNumScheduled < (int)kPositionQueueSize) {
+                fScheduled[fNumScheduled++] = position;
+                continue;
+            }
+            fPositionsEarly++;
+        } else if (position.when == 0) {
+            // Supersedes anything sent earlier, whenever that was due.
+            dropScheduledPositions(position.source);
+        } else if (position.when < blockTime) {
+            fPositionsLate++;
+        }
+        applyPosition(position);
+    }
+
+    // Input blocks are held until the DSP has read them.
+    audio_block_t* inBlock[INPUTS];
+    const int16_t* inData[INPUTS];
+    for (int channel = 0; channel < INPUTS; channel++) {
+        inBlock[channel] = receiveReadOnly(channel);
+        inData[channel] = inBlock[channel] ? inBlock[channel]->data : kSilence;
+    }
+#ifdef WFS_REFERENCE_DSP
+    // The Faust DSP only takes floats.
+    for (int channel = 0; channel < INPUTS; channel++) {
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+            fInChannel[channel][i] = inData[channel][i]*DIV_16;
+        }
+    }
+#endif
+    uint32_t inputEnd = ARM_DWT_CYCCNT;
+
+    // Render up to each scheduled position change, then apply it; usually,
+    // the whole block in one go.
+    int granularity = fRenderer ? fRenderer->getSplitGranularity() : 1;
+    for (int offset = 0; offset < AUDIO_BLOCK_SAMPLES; ) {
+        int next = applyScheduledPositions(blockTime, offset, granularity);
+        render<INPUTS, OUTPUTS>(inData, offset, next - offset);
+        offset = next;
+    }
+    for (int channel = 0; channel < INPUTS; channel++) {
+        if (inBlock[channel]) {
+            release(inBlock[channel]);
+        }
+    }
+    uint32_t renderEnd = ARM_DWT_CYCCNT;
+
+    // Speaker correction runs once per output, independent of source count.
+    for (int channel = 0; channel < OUTPUTS; channel++) {
+        fEQ[channel].process(fOutChannel[channel], AUDIO_BLOCK_SAMPLES);
+    }
+    uint32_t eqEnd = ARM_DWT_CYCCNT;
+
+    audio_block_t* outBlock[OUTPUTS];
+    for (int channel = 0; channel < OUTPUTS; channel++) {
+        outBlock[channel] = allocate();
+        if (outBlock[channel]) {
+            for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+                int16_t val = fOutChannel[channel][i]*fOutputGain[channel];
+                outBlock[channel]->data[i] = val;
+            }
+            transmit(outBlock[channel], channel);
+            release(outBlock[channel]);
+        } else {
+            fAllocationFailures[channel]++;
+        }
+    }
+    uint32_t outputEnd = ARM_DWT_CYCCNT;
+
+    // Per-stage worst cases; at small block sizes, the fixed per-block cost
+    // of the input and output stages shows up here.
+    fProfileMax.input = std::max(fProfileMax.input, inputEnd - start);
+    fProfileMax.render = std::max(fProfileMax.render, renderEnd - inputEnd);
+    fProfileMax.eq = std::max(fProfileMax.eq, eqEnd - renderEnd);
+    fProfileMax.output = std::max(fProfileMax.output, outputEnd - eqEnd);
+
+#ifdef WFS_COUNT_DENORMALS
+    if (wfs::readAndClearDenormalFlags()) {
+        fDenormalBlocks++;
+    }
+#endif
+
+    fBlockTime = blockTime + AUDIO_BLOCK_SAMPLES;
+}
+
+template <int INPUTS, int OUTPUTS>
+void WFS::render(const int16_t* const* inputs, int offset, int count)
+{
+    float* outputs[OUTPUTS];
+    for (int channel = 0; channel < OUTPUTS; channel++) {
+        outputs[channel] = fOutChannel[channel] + offset;
+    }
+#ifdef WFS_REFERENCE_DSP
+    float* in[INPUTS];
+    for (int channel = 0; channel < INPUTS; channel++) {
+        in[channel] = fInChannel[channel] + offset;
+    }
+#else
+    // The renderer converts the input as it fills its delay lines.
+    const int16_t* in[INPUTS];
+    for (int channel = 0; channel < INPUTS; channel++) {
+        in[channel] = inputs[channel] + offset;
+    }
+#endif
+    fDSP->compute(count, in, outputs);
+}
+
+int WFS::applyScheduledPositions(uint64_t blockTime, int offset, int granularity)
+{
+    // Keeps the rest in order, so that later changes to a source still win.
+    int next = AUDIO_BLOCK_SAMPLES;
+    int kept = 0;
+    for (int i = 0; i < fNumScheduled; i++) {
+        const auto& position = fScheduled[i];
+        int64_t due = static_cast<int64_t>(position.when - blockTime);
+        if (due < offset + granularity) {
+            applyPosition(position);
+        } else {
+            if (due < AUDIO_BLOCK_SAMPLES) {
+                next = std::min(next, static_cast<int>(due - due % granularity));
+            }
+            fScheduled[kept++] = position;
+        }
+    }
+    fNumScheduled = kept;
+    return next;
+}
+
+void WFS::applyPosition(const PositionUpdate& position)
+{
+    *fSourceXZone[position.source] = position.x;
+    *fSourceYZone[position.source] = position.y;
+    fPositionsApplied++;
+}
+
+void WFS::dropScheduledPositions(int source)
+{
+    int kept = 0;
+    for (int i = 0; i < fNumScheduled; i++) {
+        if (fScheduled[i].source != source) {
+            fScheduled[kept++] = fScheduled[i];
+        }
+    }
+    fNumScheduled = kept;
+}
+
+void WFS::update(void) { updateImp<FAUST_INPUTS, FAUST_OUTPUTS>(); }
+
+uint64_t WFS::getSampleTime()
+{
+    AudioNoInterrupts();
+    uint64_t blockEnd = fBlockTime;
+    uint32_t elapsed = ARM_DWT_CYCCNT - fBlockCycles;
+    AudioInterrupts();
+    // Time into the block, at most a block's worth, in case an update is
+    // overdue.
+    float cyclesPerSample = F_CPU_ACTUAL / AUDIO_SAMPLE_RATE_EXACT;
+    uint64_t into = std::min(static_cast<uint32_t>(elapsed / cyclesPerSample), static_cast<uint32_t>(AUDIO_BLOCK_SAMPLES));
+    return blockEnd >= AUDIO_BLOCK_SAMPLES ? blockEnd - AUDIO_BLOCK_SAMPLES + into : into;
+}
+
+int WFS::getParamIndex(const char* label)
+{
+    return fParams.getIndex(label);
+}
+
+void WFS::setParamValue(int index, float value)
+{
+    float* zone = fParams.getZone(index);
+    if (zone) {
+        *zone = value;
+    }
+}
+
+float WFS::getParamValue(int index)
+{
+    float* zone = fParams.getZone(index);
+    return zone ? *zone : 0.f;
+}
+
+void WFS::setParamValue(const char* label, float value)
+{
+    int index = fParams.getIndex(label);
+    if (index < 0) {
+        LOG_WARN("Unknown parameter: %s\n", label);
+        return;
+    }
+    setParamValue(index, value);
+}
+
+float WFS::getParamValue(const char* label)
+{
+    return getParamValue(fParams.getIndex(label));
+}
+
+void WFS::setSourcePosition(int source, float x, float y, uint64_t when)
+{
+    setSourceX(source, x, when);
+    setSourceY(source, y, when);
+}
+
+void WFS::setSourceX(int source, float x, uint64_t when)
+{
+    if (source >= 0 && source < kNumInputs) {
+        fStagedX[source] = x;
+        // A staged pair takes effect when its latest half is due.
+        fStagedWhen[source] = fStaged[source] ? std::max(fStagedWhen[source], when) : when;
+        fStaged[source] = true;
+    }
+}
+
+void WFS::setSourceY(int source, float y, uint64_t when)
+{
+    if (source >= 0 && source < kNumInputs) {
+        fStagedY[source] = y;
+        fStagedWhen[source] = fStaged[source] ? std::max(fStagedWhen[source], when) : when;
+        fStaged[source] = true;
+    }
+}
+
+void WFS::commitSourcePositions()
+{
+    for (int i = 0; i < kNumInputs; i++) {
+        if (!fStaged[i]) {
+            continue;
+        }
+        if (fPositionQueue.push({fStagedWhen[i], i, fStagedX[i], fStagedY[i]})) {
+            fStaged[i] = false;
+            fPositionsCommitted++;
+        } else {
+            fPositionOverflows++;
+        }
+    }
+}
+
+WFS::PositionQueueStats WFS::getPositionQueueStats()
+{
+    return {fPositionsCommitted, fPositionsApplied, fPositionOverflows, fPositionsLate, fPositionsEarly};
+}
+
+void WFS::setModuleID(int id)
+{
+    *fModuleIDZone = id;
+    for (int channel = 0; channel < FAUST_OUTPUTS; channel++) {
+        fOutputGain[channel] = MULT_16 * computeTaper(id * SPEAKERS_PER_MODULE + channel);
+    }
+}
+
+float WFS::computeTaper(int speaker)
+{
+    // Raised-cosine window across the TAPER_SPEAKERS outermost speakers at
+    // each end of the array.
+    int fromEdge = std::min(speaker, NUM_SPEAKERS - 1 - speaker);
+    if (fromEdge < 0 || fromEdge >= TAPER_SPEAKERS) {
+        return 1.f;
+    }
+    return .5f * (1.f - cosf(float(M_PI) * (fromEdge + 1) / (TAPER_SPEAKERS + 1)));
+}
+
+void WFS::setEQSection(int channel, int section, const SpeakerEQ::Section& coefficients)
+{
+    if (channel < 0 || channel >= FAUST_OUTPUTS) {
+        return;
+    }
+    // Don't let the audio update see a half-written section.
+    AudioNoInterrupts();
+    fEQ[channel].setSection(section, coefficients);
+    AudioInterrupts();
+}
+
+int WFS::getNumEQSections(int channel)
+{
+    if (channel < 0 || channel >= FAUST_OUTPUTS) {
+        return 0;
+    }
+    return fEQ[channel].getNumActiveSections();
+}
+
+bool WFS::loadEQ(int eepromAddress)
+{
+    bool loaded = true;
+    AudioNoInterrupts();
+    for (int channel = 0; channel < FAUST_OUTPUTS; channel++) {
+        if (!fEQ[channel].load(eepromAddress + channel * SpeakerEQ::kStorageSize)) {
+            fEQ[channel].reset();
+            loaded = false;
+        }
+    }
+    AudioInterrupts();
+    return loaded;
+}
+
+void WFS::storeEQ(int eepromAddress)
+{
+    for (int channel = 0; channel < FAUST_OUTPUTS; channel++) {
+        fEQ[channel].store(eepromAddress + channel * SpeakerEQ::kStorageSize);
+    }
+}
+
+void WFS::setSpeakerGeometry(int speaker, const ArrayGeometry::Speaker& geometry)
+{
+    fGeometry.setSpeaker(speaker, geometry);
+    applyGeometry();
+}
+
+void WFS::resetGeometry()
+{
+    fGeometry.reset();
+    applyGeometry();
+}
+
+bool WFS::loadGeometry(int eepromAddress)
+{
+    if (!fGeometry.load(eepromAddress)) {
+        return false;
+    }
+    applyGeometry();
+    return true;
+}
+
+void WFS::storeGeometry(int eepromAddress)
+{
+    fGeometry.store(eepromAddress);
+}
+
+void WFS::applyGeometry()
+{
+    if (fRenderer) {
+        // The renderer copies the table; don't let the audio update see it
+        // half-written.
+        AudioNoInterrupts();
+        fRenderer->setGeometry(fGeometry);
+        AudioInterrupts();
+    }
+}
+
+void WFS::setFlushToZero(bool enable)
+{
+    fFlushToZero = enable;
+}
+
+#ifdef WFS_COUNT_DENORMALS
+uint32_t WFS::getDenormalBlockCount()
+{
+    return fDenormalBlocks;
+}
+#endif
+
+#if defined(WFS_SELF_CHECK) && !defined(WFS_REFERENCE_DSP)
+static bool runRenderCheck(const char* mode, float sharedFilter, const wfs::RenderCheck::Tolerance& tolerance)
+{
+    auto* reference = new (std::nothrow) mydsp();
+    auto* candidate = new (std::nothrow) wfs_renderer_dsp();
+    if (reference == NULL || candidate == NULL) {
+        Serial.printf("Self-check (%s): out of memory\n", mode);
+        delete reference;
+        delete candidate;
+        return false;
+    }
+
+    *candidate->getRenderer().getSharedFilterZone() = sharedFilter;
+
+    wfs::RenderCheck::Result results[wfs::RenderCheck::kNumResults];
+    auto passed = wfs::RenderCheck::run(*reference, *candidate, AUDIO_SAMPLE_RATE_EXACT, tolerance, results);
+
+    for (int i = 0; i < wfs::RenderCheck::kNumResults; i++) {
+        const auto& result = results[i];
+        Serial.printf("Self-check (%s) %-7s speaker %d: max error %e, SNR %.1f dB, lag %d: %s\n",
+                      mode, wfs::RenderCheck::getSignalName(result.signal), result.speaker,
+                      result.maxError, result.snr, result.lag, result.passed ? "ok" : "FAILED");
+    }
+
+    delete reference;
+    delete candidate;
+    return passed;
+}
+
+bool WFS::runSelfCheck()
+{
+    // Exact mode matches the Faust DSP to rounding; shared-filter mode trades
+    // accuracy for speed, but shouldn't move anything in time.
+    auto passed = runRenderCheck("exact", 0.f, {1e-4f, 100.f, 0});
+    passed = runRenderCheck("shared filter", 1.f, {.25f, 15.f, 0}) && passed;
+    Serial.printf("Self-check %s\n", passed ? "passed" : "FAILED");
+    return passed;
+}
+#endif
+
+void WFS::printMemoryReport()
+{
+    fArena.printReport();
+    Arena::printRegionReport();
+}
+
+uint32_t WFS::getAllocationFailures(int channel)
+{
+    return channel >= 0 && channel < kNumOutputs ? fAllocationFailures[channel] : 0;
+}
+
+const WFS::Profile& WFS::getProfileMax()
+{
+    return fProfileMax;
+}
+
+void WFS::resetProfileMax()
+{
+    fProfileMax.input = 0;
+    fProfileMax.render = 0;
+    fProfileMax.eq = 0;
+    fProfileMax.output = 0;
+}
+
+/********************END ARCHITECTURE SECTION (part 2/2)****************/
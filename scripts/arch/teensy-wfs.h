@@ -0,0 +1,232 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2019-2020 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+ 
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+ 
+ ************************************************************************/
+
+#ifndef faust_WFS_h_
+#define faust_WFS_h_
+
+#include "Arduino.h"
+#include "AudioStream.h"
+#include "Audio.h"
+#include "SpeakerEQ.h"
+#include "ArrayGeometry.h"
+#include "ParamTable.h"
+#include "Arena.h"
+#include "SPSCQueue.h"
+#include "WFSParams.h"
+
+class WFSRenderer;
+
+// The DSP is held by its concrete (final) type, so that its methods are
+// called directly rather than through a vtable.
+#ifdef WFS_REFERENCE_DSP
+class wfs_reference_dsp;
+typedef wfs_reference_dsp wfs_dsp;
+#else
+class wfs_renderer_dsp;
+typedef wfs_renderer_dsp wfs_dsp;
+#endif
+
+class WFS : public AudioStream
+{
+    public:
+    
+        WFS();
+        ~WFS();
+    
+        virtual void update(void);
+    
+        // Parameters are addressed by label, e.g. "0/x"; looking a label up
+        // once and then using its index avoids a search per call.
+        int getParamIndex(const char* label);
+        void setParamValue(int index, float value);
+        float getParamValue(int index);
+        void setParamValue(const char* label, float value);
+        float getParamValue(const char* label);
+    
+        // Samples rendered since boot, plus the time into the current block;
+        // the clock against which positions are scheduled.
+        uint64_t getSampleTime();
+    
+        // Source positions, normalised 0-1 as WFS.dsp's co-ordinates. These
+        // are staged, and only reach the DSP, as complete (x, y) pairs, once
+        // committed; call from loop() only. A position is applied at the
+        // given sample time (see getSampleTime()), to the sample, or, for 0
+        // or a time already past, at the start of the next block. In subband
+        // mode, blocks can only be split every four samples, so a position
+        // is applied at the start of the four holding its time, up to three
+        // samples early, and ramps in over them.
+        void setSourcePosition(int source, float x, float y, uint64_t when = 0);
+        void setSourceX(int source, float x, uint64_t when = 0);
+        void setSourceY(int source, float y, uint64_t when = 0);
+        // Queues the staged positions for the audio update. Positions that
+        // don't fit in the queue stay staged, and are merged with any later
+        // changes, until the next commit.
+        void commitSourcePositions();
+    
+        struct PositionQueueStats {
+            // Positions queued, and applied by the audio update.
+            uint32_t committed;
+            uint32_t applied;
+            // Commits held back because the queue was full.
+            uint32_t overflows;
+            // Scheduled positions that arrived after their time.
+            uint32_t late;
+            // Scheduled positions applied early, for want of room to hold
+            // them until their time.
+            uint32_t early;
+        };
+        PositionQueueStats getPositionQueueStats();
+    
+        // Sets the module's position in the array, and with it the edge
+        // taper applied to its outputs.
+        void setModuleID(int id);
+    
+        // Per-speaker correction EQ, applied once per output after the mix.
+        void setEQSection(int channel, int section, const SpeakerEQ::Section& coefficients);
+        int getNumEQSections(int channel);
+        bool loadEQ(int eepromAddress);
+        void storeEQ(int eepromAddress);
+    
+        // Speaker positions and normals for the whole array. Ignored by the
+        // Faust-generated DSP, which assumes a straight, evenly spaced line.
+        void setSpeakerGeometry(int speaker, const ArrayGeometry::Speaker& geometry);
+        void resetGeometry();
+        bool loadGeometry(int eepromAddress);
+        void storeGeometry(int eepromAddress);
+    
+        // Worst-case cycles per audio block spent in each stage of update(),
+        // since the last reset.
+        struct Profile {
+            uint32_t input;
+            uint32_t render;
+            uint32_t eq;
+            uint32_t output;
+        };
+        const Profile& getProfileMax();
+        void resetProfileMax();
+    
+        // Number of output blocks dropped, per channel, since boot, for want
+        // of free audio memory.
+        uint32_t getAllocationFailures(int channel);
+    
+        // Flush subnormal floats to zero while processing audio (on by
+        // default).
+        void setFlushToZero(bool enable);
+    
+    #ifdef WFS_COUNT_DENORMALS
+        // Number of audio blocks in which the FPU has encountered a subnormal
+        // operand or result; see FlushToZero.h.
+        uint32_t getDenormalBlockCount();
+    #endif
+    
+        // Prints where the DSP's state lives, and the memory in use in each
+        // region; see Arena.h.
+        void printMemoryReport();
+    
+    #if defined(WFS_SELF_CHECK) && !defined(WFS_REFERENCE_DSP)
+        // Compares the renderer against the Faust-generated DSP, in exact and
+        // shared-filter modes, and prints the results; see RenderCheck.h.
+        // Uses a spare renderer, so may be called before audio starts.
+        static bool runSelfCheck();
+    #endif
+    
+    private:
+    
+        template <int INPUTS, int OUTPUTS>
+        void updateImp(void);
+    
+        template <int INPUTS, int OUTPUTS>
+        void render(const int16_t* const* inputs, int offset, int count);
+    
+        // Applies the scheduled positions due by the given offset into the
+        // block starting at blockTime, rounded to granularity.
+        // @return The offset of the next position due within the block, or
+        // AUDIO_BLOCK_SAMPLES.
+        int applyScheduledPositions(uint64_t blockTime, int offset, int granularity);
+        struct PositionUpdate;
+        void applyPosition(const PositionUpdate& position);
+        // Forgets any positions scheduled for a source, e.g. once it's been
+        // moved immediately.
+        void dropScheduledPositions(int source);
+    
+        static float computeTaper(int speaker);
+    
+        void applyGeometry();
+    
+        static constexpr int kNumInputs = NUM_SOURCES;
+        static constexpr int kNumOutputs = SPEAKERS_PER_MODULE;
+    
+        audio_block_t* fInputQueue[kNumInputs];
+        // Holds the DSP and its I/O buffers, in the region selected at build
+        // time. There's memory for one WFS object's arena.
+        Arena fArena;
+    #ifdef WFS_REFERENCE_DSP
+        float* fInChannel[kNumInputs];
+    #endif
+        float* fOutChannel[kNumOutputs];
+        ParamTable fParams;
+        // Zones of the parameters set most often, looked up on construction.
+        float* fSourceXZone[kNumInputs];
+        float* fSourceYZone[kNumInputs];
+        float* fModuleIDZone;
+    
+        // Source positions pass from loop() to update() through a queue, so
+        // that a block never sees half of a position change. Those due in a
+        // later block wait, in the audio update's hands, in fScheduled.
+        struct PositionUpdate {
+            uint64_t when;
+            int source;
+            float x, y;
+        };
+        static constexpr uint32_t kPositionQueueSize = 64;
+        static_assert(kNumInputs <= kPositionQueueSize, "The position queue must hold a commit of every source");
+        SPSCQueue<PositionUpdate, kPositionQueueSize> fPositionQueue;
+        PositionUpdate fScheduled[kPositionQueueSize];
+        int fNumScheduled;
+        float fStagedX[kNumInputs];
+        float fStagedY[kNumInputs];
+        uint64_t fStagedWhen[kNumInputs];
+        bool fStaged[kNumInputs];
+        uint32_t fPositionsCommitted;
+        uint32_t fPositionOverflows;
+        volatile uint32_t fPositionsApplied;
+        volatile uint32_t fPositionsLate;
+        volatile uint32_t fPositionsEarly;
+        // Sample time and cycle count at the start of the latest block.
+        uint64_t fBlockTime;
+        uint32_t fBlockCycles;
+        float fOutputGain[kNumOutputs];
+        SpeakerEQ fEQ[kNumOutputs];
+        ArrayGeometry fGeometry;
+        WFSRenderer* fRenderer;
+        Profile fProfileMax;
+        volatile uint32_t fAllocationFailures[kNumOutputs];
+        bool fFlushToZero;
+    #ifdef WFS_COUNT_DENORMALS
+        volatile uint32_t fDenormalBlocks;
+    #endif
+        wfs_dsp* fDSP;
+};
+
+#endif
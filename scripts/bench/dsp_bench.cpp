@@ -0,0 +1,115 @@
+/*
+ * Host benchmark for a Faust-generated WFS DSP class; see
+ * scripts/faust-options.sh. Build with MYDSP_HEADER naming the generated
+ * class (compiled without an architecture file) and src/WFS on the include
+ * path.
+ *
+ * Prints one line of key=value pairs: time and (on x86) TSC ticks per sample
+ * frame, and the size of the DSP object.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "ParamTable.h"
+
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 32
+#endif
+
+// Just enough of Faust's dsp, Meta and UI interfaces; as scripts/arch.
+class dsp {
+    public:
+        virtual ~dsp() {}
+};
+
+struct Meta {
+    void declare(const char* key, const char* value) {}
+};
+
+typedef ParamTable UI;
+
+#include MYDSP_HEADER
+
+static void setParam(ParamTable& params, const char* label, float value)
+{
+    float* zone = params.getZone(params.getIndex(label));
+    if (zone) {
+        *zone = value;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int numBlocks = argc > 1 ? atoi(argv[1]) : 20000;
+    const int numRuns = 10;
+
+    static mydsp dsp;
+    dsp.init(44100);
+    ParamTable params;
+    dsp.buildUserInterface(&params);
+
+    const int numInputs = dsp.getNumInputs();
+    const int numOutputs = dsp.getNumOutputs();
+
+    // Sources spread over the array and the listening area, and a module
+    // from the middle of the array, so that every source is audible.
+    char label[16];
+    for (int i = 0; i < numInputs; i++) {
+        snprintf(label, sizeof(label), "%d/x", i);
+        setParam(params, label, float((i * 13 + 5) % 100) / 100.f);
+        snprintf(label, sizeof(label), "%d/y", i);
+        setParam(params, label, float((i * 29 + 7) % 100) / 100.f);
+    }
+    setParam(params, "moduleID", float(NUM_SPEAKERS / SPEAKERS_PER_MODULE / 2));
+
+    static float inBuffer[NUM_SOURCES][AUDIO_BLOCK_SAMPLES];
+    static float outBuffer[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+    float* inputs[NUM_SOURCES];
+    float* outputs[SPEAKERS_PER_MODULE];
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    for (int i = 0; i < numInputs; i++) {
+        inputs[i] = inBuffer[i];
+        for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+            inBuffer[i][n] = noise(rng);
+        }
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        outputs[i] = outBuffer[i];
+    }
+
+    // Let the parameter smoothing settle, then take the best of several runs.
+    for (int b = 0; b < numBlocks; b++) {
+        dsp.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+    }
+    double bestSeconds = 1e9;
+    unsigned long long bestTicks = ~0ull;
+    for (int r = 0; r < numRuns; r++) {
+        auto start = std::chrono::steady_clock::now();
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned long long startTicks = __rdtsc();
+#endif
+        for (int b = 0; b < numBlocks; b++) {
+            dsp.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+        }
+#if defined(__x86_64__) || defined(__i386__)
+        bestTicks = std::min(bestTicks, __rdtsc() - startTicks);
+#endif
+        bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    const double samples = double(numBlocks) * AUDIO_BLOCK_SAMPLES;
+    printf("ns_per_sample=%.2f", 1e9 * bestSeconds / samples);
+#if defined(__x86_64__) || defined(__i386__)
+    printf(" ticks_per_sample=%.1f", double(bestTicks) / samples);
+#endif
+    printf(" dsp_bytes=%zu\n", sizeof(mydsp));
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Host benchmark of the speaker correction EQ: both of a module's outputs
+ * through 4, 8 and 16 active sections (build with EQ_MAX_SECTIONS=16; see
+ * the Makefile alongside), against rendering ten sources in exact mode, for
+ * scale. Prints one markdown table row per section count, in ns per block,
+ * best of several runs.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "SpeakerEQ.h"
+#include "WFSRenderer.h"
+
+static_assert(EQ_MAX_SECTIONS >= 16, "Build with -DEQ_MAX_SECTIONS=16");
+
+namespace {
+
+constexpr int kRuns{20};
+
+WFSRenderer renderer;
+SpeakerEQ eq[SPEAKERS_PER_MODULE];
+float inBuffer[NUM_SOURCES][AUDIO_BLOCK_SAMPLES];
+float outBuffer[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+float rendered[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+float *inputs[NUM_SOURCES];
+float *outputs[SPEAKERS_PER_MODULE];
+
+template<class F>
+double time(F process, int blocks) {
+    double best{1e30};
+    for (int r{0}; r < kRuns; ++r) {
+        auto start{std::chrono::steady_clock::now()};
+        for (int b{0}; b < blocks; ++b) {
+            process();
+        }
+        std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+        best = std::min(best, elapsed.count() / blocks);
+    }
+    return best;
+}
+
+void render() {
+    renderer.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+}
+
+void equalise() {
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        eq[k].process(outBuffer[k], AUDIO_BLOCK_SAMPLES);
+    }
+}
+
+}
+
+int main(int argc, char **argv) {
+    const int blocks{argc > 1 ? atoi(argv[1]) : 5000};
+
+    renderer.init(44100);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        *renderer.getSourceXZone(s) = static_cast<float>((s * 13 + 5) % 100) / 100.f;
+        *renderer.getSourceYZone(s) = static_cast<float>((s * 29 + 7) % 100) / 100.f;
+        inputs[s] = inBuffer[s];
+        for (auto &sample: inBuffer[s]) {
+            sample = noise(rng);
+        }
+    }
+    *renderer.getModuleIDZone() = static_cast<float>(NUM_SPEAKERS / SPEAKERS_PER_MODULE / 2);
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        outputs[k] = outBuffer[k];
+    }
+    const auto renderTime{time(render, blocks)};
+    std::copy(&outBuffer[0][0], &outBuffer[0][0] + SPEAKERS_PER_MODULE * AUDIO_BLOCK_SAMPLES, &rendered[0][0]);
+
+    printf("| Sections | EQ (ns/block) | ns/section | EQ vs. rendering |\n");
+    printf("|---|---|---|---|\n");
+    for (auto numSections: {4, 8, 16}) {
+        // Alternating gentle peaks and dips; the coefficients don't affect
+        // the cost, so long as the output stays out of the subnormal range.
+        for (auto &e: eq) {
+            e.reset();
+            for (int s{0}; s < numSections; ++s) {
+                e.setSection(s, s % 2 ? SpeakerEQ::Section{1.0245f, -1.9460f, .9245f, -1.9470f, .9480f} :
+                                SpeakerEQ::Section{.9812f, -1.8050f, .8510f, -1.8050f, .8322f});
+            }
+        }
+        // Refill the output each block with a rendered one, as the renderer
+        // would, so it doesn't decay.
+        const auto eqTime{time([] {
+            std::copy(&rendered[0][0], &rendered[0][0] + SPEAKERS_PER_MODULE * AUDIO_BLOCK_SAMPLES,
+                      &outBuffer[0][0]);
+            equalise();
+        }, blocks)};
+        printf("| %d | %.0f | %.1f | %.0f%% |\n", numSections, eqTime, eqTime / numSections,
+               100. * eqTime / renderTime);
+    }
+    return 0;
+}
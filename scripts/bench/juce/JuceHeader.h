@@ -0,0 +1,78 @@
+#ifndef TEENSY_WFS_BENCH_JUCEHEADER_H
+#define TEENSY_WFS_BENCH_JUCEHEADER_H
+
+// Host stand-in for the few JUCE classes the controller's DSP uses, so that
+// it can be benchmarked without JUCE: SIMDRegister<float> on SSE (as JUCE's
+// on x86-64), and a minimal AudioBuffer.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <xmmintrin.h>
+
+namespace juce {
+
+template<typename T>
+T jmin(T a, T b) {
+    return std::min(a, b);
+}
+
+template<typename T>
+struct MathConstants {
+    static constexpr T pi{static_cast<T>(3.141592653589793238)};
+};
+
+template<typename T>
+class AudioBuffer {
+public:
+    AudioBuffer(int numChannels, int numSamples) :
+            numChannels(numChannels), numSamples(numSamples),
+            data(static_cast<size_t>(numChannels * numSamples)) {}
+
+    int getNumChannels() const { return numChannels; }
+
+    int getNumSamples() const { return numSamples; }
+
+    T *getWritePointer(int channel, int sample = 0) {
+        return data.data() + channel * numSamples + sample;
+    }
+
+private:
+    int numChannels, numSamples;
+    std::vector<T> data;
+};
+
+namespace dsp {
+
+template<typename T>
+struct SIMDRegister;
+
+template<>
+struct SIMDRegister<float> {
+    static constexpr size_t SIMDRegisterSize{sizeof(__m128)};
+    static constexpr size_t SIMDNumElements{SIMDRegisterSize / sizeof(float)};
+
+    __m128 value;
+
+    static SIMDRegister expand(float s) { return {_mm_set1_ps(s)}; }
+
+    static SIMDRegister fromRawArray(const float *a) { return {_mm_load_ps(a)}; }
+
+    void copyToRawArray(float *a) const { _mm_store_ps(a, value); }
+
+    SIMDRegister operator+(SIMDRegister o) const { return {_mm_add_ps(value, o.value)}; }
+
+    SIMDRegister operator-(SIMDRegister o) const { return {_mm_sub_ps(value, o.value)}; }
+
+    SIMDRegister operator*(SIMDRegister o) const { return {_mm_mul_ps(value, o.value)}; }
+};
+
+}
+
+}
+
+using namespace juce;
+
+#endif //TEENSY_WFS_BENCH_JUCEHEADER_H
@@ -0,0 +1,116 @@
+/*
+ * Host benchmark of the controller's pre-equalisation filter
+ * (wfs-controller/PreEqualiser.cpp), built against a stand-in for JUCE
+ * (juce/JuceHeader.h; SIMDRegister on SSE, as JUCE's on x86-64). Times one
+ * block of each source count, at the controller's default block size, and
+ * compares it with filtering each channel on its own, without SIMD. Prints
+ * one markdown table row per source count, in ns per block, best of several
+ * runs.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "PreEqualiser.h"
+
+namespace {
+
+constexpr int kRuns{20};
+constexpr int kBlockSize{512};
+constexpr double kSampleRate{48000.};
+
+/**
+ * The same filter, one channel at a time, in plain floats; coefficients as
+ * PreEqualiser::prepare().
+ */
+class ScalarPreEqualiser {
+public:
+    ScalarPreEqualiser(int numChannels, double sampleRate) : state(static_cast<size_t>(numChannels * kSections)) {
+        auto fs{static_cast<float>(sampleRate)};
+        auto k{2.f * fs};
+        auto highFrequency{std::min(343.f / (2.f * SPEAKER_DIST), .45f * fs)};
+        auto ratio{std::pow(highFrequency / 50.f, 1.f / kSections)};
+        for (int i{0}; i < kSections; ++i) {
+            auto zero{50.f * std::pow(ratio, static_cast<float>(i))};
+            auto pole{zero * std::sqrt(ratio)};
+            auto wz{k * std::tan(MathConstants<float>::pi * zero / fs)};
+            auto wp{k * std::tan(MathConstants<float>::pi * pole / fs)};
+            auto norm{1.f / (k + wp)};
+            b0[i] = (k + wz) * norm;
+            b1[i] = (wz - k) * norm;
+            a1[i] = (wp - k) * norm;
+        }
+    }
+
+    void process(AudioBuffer<float> &buffer, int numSamples) {
+        for (int c{0}; c < buffer.getNumChannels(); ++c) {
+            auto *x{buffer.getWritePointer(c)};
+            auto *s{&state[static_cast<size_t>(c * kSections)]};
+            for (int n{0}; n < numSamples; ++n) {
+                auto v{x[n]};
+                for (int i{0}; i < kSections; ++i) {
+                    auto y{b0[i] * v + s[i]};
+                    s[i] = b1[i] * v - a1[i] * y;
+                    v = y;
+                }
+                x[n] = v;
+            }
+        }
+    }
+
+private:
+    static constexpr int kSections{4};
+
+    float b0[kSections], b1[kSections], a1[kSections];
+    std::vector<float> state;
+};
+
+void fill(AudioBuffer<float> &buffer) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    for (int c{0}; c < buffer.getNumChannels(); ++c) {
+        for (int n{0}; n < buffer.getNumSamples(); ++n) {
+            buffer.getWritePointer(c)[n] = noise(rng);
+        }
+    }
+}
+
+template<class F>
+double time(F process, AudioBuffer<float> &buffer, int blocks) {
+    double best{1e30};
+    for (int r{0}; r < kRuns; ++r) {
+        fill(buffer);
+        auto start{std::chrono::steady_clock::now()};
+        for (int b{0}; b < blocks; ++b) {
+            process();
+        }
+        std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+        best = std::min(best, elapsed.count() / blocks);
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char **argv) {
+    const int blocks{argc > 1 ? atoi(argv[1]) : 2000};
+
+    printf("| Sources | SIMD (ns/block) | Scalar (ns/block) | SIMD vs. scalar |\n");
+    printf("|---|---|---|---|\n");
+    for (auto numChannels: {2, 4, 10, 16}) {
+        AudioBuffer<float> buffer{numChannels, kBlockSize};
+        PreEqualiser simd{numChannels};
+        simd.prepare(kSampleRate);
+        simd.setEnabled(true);
+
+        ScalarPreEqualiser scalar{numChannels, kSampleRate};
+
+        const auto simdTime{time([&] { simd.process(buffer, 0, kBlockSize); }, buffer, blocks)};
+        const auto scalarTime{time([&] { scalar.process(buffer, kBlockSize); }, buffer, blocks)};
+        printf("| %d | %.0f | %.0f | %+.0f%% |\n", numChannels, simdTime, scalarTime,
+               100. * (simdTime / scalarTime - 1.));
+    }
+    return 0;
+}
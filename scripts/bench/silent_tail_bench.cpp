@@ -0,0 +1,112 @@
+/*
+ * Host benchmark of the renderer and speaker EQ on a silent tail: ten
+ * sources play noise, then fall silent, leaving their recursive filter
+ * states to decay. Without state flushing (build with -DWFS_NO_STATE_FLUSH)
+ * or a flush-to-zero FPU mode, the decay passes through the subnormal range,
+ * which is slow to process.
+ *
+ * Each run is timed with the host FPU's FTZ/DAZ modes off and on; the latter
+ * stands in for the FPSCR.FZ mode that WFS::update() sets on the Teensy. See
+ * the Makefile alongside; prints one markdown table row per mode.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#if defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#endif
+
+#include "SpeakerEQ.h"
+#include "WFSRenderer.h"
+
+namespace {
+
+constexpr int kNoiseBlocks{2000};
+
+WFSRenderer renderer;
+SpeakerEQ eq[SPEAKERS_PER_MODULE];
+float inBuffer[NUM_SOURCES][AUDIO_BLOCK_SAMPLES];
+float outBuffer[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+float *inputs[NUM_SOURCES];
+float *outputs[SPEAKERS_PER_MODULE];
+
+void setUp() {
+    renderer.init(44100);
+    // Sources spread over the array and the listening area, and a module from
+    // the middle of the array, so that every source is audible.
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        *renderer.getSourceXZone(s) = static_cast<float>((s * 13 + 5) % 100) / 100.f;
+        *renderer.getSourceYZone(s) = static_cast<float>((s * 29 + 7) % 100) / 100.f;
+        inputs[s] = inBuffer[s];
+    }
+    *renderer.getModuleIDZone() = static_cast<float>(NUM_SPEAKERS / SPEAKERS_PER_MODULE / 2);
+    // A typical correction: a low shelf and a presence dip.
+    for (auto &e: eq) {
+        e.setSection(0, {1.0245f, -1.9460f, .9245f, -1.9470f, .9480f});
+        e.setSection(1, {.9812f, -1.8050f, .8510f, -1.8050f, .8322f});
+    }
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        outputs[k] = outBuffer[k];
+    }
+}
+
+void process() {
+    renderer.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        eq[k].process(outBuffer[k], AUDIO_BLOCK_SAMPLES);
+    }
+}
+
+/**
+ * @return Mean microseconds per block over the silent tail.
+ */
+double run(int tailBlocks) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    renderer.clear();
+    for (auto &e: eq) {
+        e.clear();
+    }
+
+    for (int b{0}; b < kNoiseBlocks; ++b) {
+        for (auto &channel: inBuffer) {
+            for (auto &sample: channel) {
+                sample = noise(rng);
+            }
+        }
+        process();
+    }
+
+    for (auto &channel: inBuffer) {
+        for (auto &sample: channel) {
+            sample = 0.f;
+        }
+    }
+    auto start{std::chrono::steady_clock::now()};
+    for (int b{0}; b < tailBlocks; ++b) {
+        process();
+    }
+    std::chrono::duration<double, std::micro> elapsed{std::chrono::steady_clock::now() - start};
+    return elapsed.count() / tailBlocks;
+}
+
+}
+
+int main(int argc, char **argv) {
+    const int tailBlocks{argc > 1 ? atoi(argv[1]) : 20000};
+#ifdef WFS_NO_STATE_FLUSH
+    const char *flushing{"off"};
+#else
+    const char *flushing{"on"};
+#endif
+
+    setUp();
+    printf("| %s | off | %.2f |\n", flushing, run(tailBlocks));
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_setcsr(_mm_getcsr() | _MM_FLUSH_ZERO_ON | 0x0040);  // FTZ | DAZ
+    printf("| %s | on | %.2f |\n", flushing, run(tailBlocks));
+#endif
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Host benchmark of the renderer's three rendering modes: exact per-speaker
+ * filtering, the shared distance filter (/sharedfilter 1) and subband
+ * rendering (/subband 1), with every source playing. Build with
+ * SPEAKERS_PER_MODULE defined to compare module sizes; see the Makefile
+ * alongside. Prints one markdown table row, in ns per block, best of several
+ * runs.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "WFSRenderer.h"
+
+namespace {
+
+constexpr int kRuns{20};
+
+WFSRenderer renderer;
+float inBuffer[NUM_SOURCES][AUDIO_BLOCK_SAMPLES];
+float outBuffer[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+float *inputs[NUM_SOURCES];
+float *outputs[SPEAKERS_PER_MODULE];
+
+void setUp() {
+    renderer.init(44100);
+    // Sources spread along the array, from 1 m to 10 m from it, and a module
+    // from the middle of the array.
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        *renderer.getSourceXZone(s) = static_cast<float>((s * 13 + 5) % 100) / 100.f;
+        *renderer.getSourceYZone(s) = (1.f + 9.f * s / (NUM_SOURCES - 1)) / MAX_Y_DIST;
+        inputs[s] = inBuffer[s];
+    }
+    *renderer.getModuleIDZone() = static_cast<float>(NUM_SPEAKERS / SPEAKERS_PER_MODULE / 2);
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        outputs[k] = outBuffer[k];
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    for (auto &channel: inBuffer) {
+        for (auto &sample: channel) {
+            sample = noise(rng);
+        }
+    }
+}
+
+/**
+ * @return Nanoseconds per block, best of kRuns.
+ */
+double run(float sharedFilter, float subband, int blocks) {
+    *renderer.getSharedFilterZone() = sharedFilter;
+    *renderer.getSubbandZone() = subband;
+    // Let the mode switch, and the delay lines fill.
+    for (int b{0}; b < 100; ++b) {
+        renderer.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+    }
+
+    double best{1e30};
+    for (int r{0}; r < kRuns; ++r) {
+        auto start{std::chrono::steady_clock::now()};
+        for (int b{0}; b < blocks; ++b) {
+            renderer.compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+        }
+        std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+        best = std::min(best, elapsed.count() / blocks);
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char **argv) {
+    const int blocks{argc > 1 ? atoi(argv[1]) : 5000};
+
+    setUp();
+    const auto exact{run(0.f, 0.f, blocks)};
+    const auto shared{run(1.f, 0.f, blocks)};
+    const auto subband{run(0.f, 1.f, blocks)};
+    printf("| %d | %.0f | %.0f | %.0f | %+.0f%% |\n", SPEAKERS_PER_MODULE, exact, shared, subband,
+           100. * (subband / shared - 1.));
+    return 0;
+}
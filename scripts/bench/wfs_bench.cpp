@@ -0,0 +1,76 @@
+/*
+ * Host benchmark of the WFS object's audio update, as the serial performance
+ * report measures it on the Teensy: input conversion, rendering, EQ and
+ * output conversion, with every source playing. Build with
+ * AUDIO_SAMPLE_RATE_EXACT, MAX_SAMPLE_RATE and AUDIO_BLOCK_SAMPLES defined to
+ * compare configurations; see the Makefile alongside. Prints one markdown
+ * table row: ns per block and per sample, best of several runs, and the share
+ * of the block period that is (of the host's CPU, not the Teensy's).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "WFS.cpp"
+
+namespace {
+
+constexpr int kRuns{20};
+
+audio_block_t inBlocks[NUM_SOURCES];
+
+std::unique_ptr<WFS> setUp() {
+    std::unique_ptr<WFS> wfs{new WFS()};
+    // Sources spread along the array, from 1 m to 10 m from it, and a module
+    // from the middle of the array.
+    wfs->setModuleID(NUM_SPEAKERS / SPEAKERS_PER_MODULE / 2);
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        wfs->setSourcePosition(s, static_cast<float>((s * 13 + 5) % 100) / 100.f,
+                               (1.f + 9.f * s / (NUM_SOURCES - 1)) / MAX_Y_DIST);
+    }
+    wfs->commitSourcePositions();
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> noise(-8000, 8000);
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        for (auto &sample: inBlocks[s].data) {
+            sample = static_cast<int16_t>(noise(rng));
+        }
+        hostInputs[s] = &inBlocks[s];
+    }
+    return wfs;
+}
+
+}
+
+int main(int argc, char **argv) {
+    static_assert(NUM_SOURCES <= kHostMaxChannels, "More sources than host inputs");
+    // As many samples as 5000 32-sample blocks, whatever the block size.
+    const long samples{argc > 1 ? atol(argv[1]) : 160000};
+    const long blocks{std::max(1L, samples / AUDIO_BLOCK_SAMPLES)};
+
+    auto wfs{setUp()};
+    // Let the delay lines fill.
+    for (int b{0}; b < 100; ++b) {
+        wfs->update();
+    }
+
+    double best{1e30};
+    for (int r{0}; r < kRuns; ++r) {
+        auto start{std::chrono::steady_clock::now()};
+        for (long b{0}; b < blocks; ++b) {
+            wfs->update();
+        }
+        std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+        best = std::min(best, elapsed.count() / static_cast<double>(blocks));
+    }
+
+    const double period{1e9 * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT};
+    printf("| %.1f | %d | %.0f | %.1f | %.2f%% |\n", AUDIO_SAMPLE_RATE_EXACT / 1000., AUDIO_BLOCK_SAMPLES,
+           best, best / AUDIO_BLOCK_SAMPLES, 100. * best / period);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #!/bin/bash
-# Wrapper for faust2teensy
+# Compile a .dsp file to a Teensy AudioStream object, using this project's
+# architecture files (scripts/arch) rather than faust2teensy's.
 file=$1
 faustFlags=${@:2}
 
@@ -7,6 +8,8 @@ if [ -z "$file" ]; then
   echo "Expected to receive a .dsp file"
 fi
 
+archDir=$(dirname "$(realpath "$0")")/arch
+
 # Move to directory holding the dsp file.
 dir=$(dirname "$(realpath "$1")")
 cd "$dir" || exit 1
@@ -14,14 +17,12 @@ cd "$dir" || exit 1
 if [[ $file == *.dsp ]]; then
   name=$(basename "$file" .dsp)
   echo "Generating faust object."
-  # Faust object needs UI macros for FAUST_INPUTS, etc.;
-  faust2teensy -lib $name.dsp $faustFlags
-  cd ..
-  echo "Extracting archive to $(pwd)/$name"
-  unzip -qo "$dir/$name".zip
-  echo "Tidying up."
-  rm "$dir/$name".zip
+  # Options as faust2teensy; -uim for FAUST_INPUTS, etc.
+  mkdir -p "../$name"
+  faust -A "$archDir" -a teensy-wfs.cpp -lang cpp -i -es 1 -mcd 16 -uim -single -ftz 0 \
+    $faustFlags "$name.dsp" -o "../$name/$name.cpp" || exit 1
+  cp "$archDir/teensy-wfs.h" "../$name/$name.h"
   echo "Done"
 else
-  echo "Usage: faust2teensy.sh [filename].dsp"
+  echo "Usage: f2t.sh [filename].dsp"
 fi
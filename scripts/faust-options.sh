@@ -0,0 +1,101 @@
+#!/bin/bash
+# Regenerate a .dsp file under a matrix of Faust compilation options, and run
+# each result through the host benchmark (scripts/bench/dsp_bench.cpp).
+# Prints a markdown table of time per sample and memory for each option set.
+#
+# Usage: faust-options.sh [filename].dsp [option set]...
+# With no option sets, the defaults below are compared. Set CXX, CXXFLAGS,
+# BLOCK_SIZE (default 32) and BLOCKS (per timed run, default 20000) to taste.
+# If ARM_CXX names an arm-none-eabi-g++ (e.g. from PlatformIO's Teensy
+# toolchain), code size is also reported for the Teensy's Cortex-M7.
+file=$1
+
+if [[ $file != *.dsp ]]; then
+  echo "Usage: faust-options.sh [filename].dsp [option set]..."
+  exit 1
+fi
+
+if ! command -v faust &>/dev/null; then
+  echo "Error: requires the Faust compiler, which was not found" >&2
+  exit 1
+fi
+
+scriptDir=$(dirname "$(realpath "$0")")
+rootDir=$(realpath "$scriptDir/..")
+dsp=$(realpath "$file")
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+BLOCK_SIZE=${BLOCK_SIZE:-32}
+BLOCKS=${BLOCKS:-20000}
+
+if (($# > 1)); then
+  configs=("${@:2}")
+else
+  configs=(
+    # As used for src/WFS/WFS.cpp
+    "-es 1 -mcd 16 -single -ftz 0"
+    # Delay line strategies
+    "-es 1 -mcd 0 -single -ftz 0"
+    "-es 1 -mcd 64 -single -ftz 0"
+    "-es 1 -mcd 16 -dlt 256 -single -ftz 0"
+    "-es 1 -mcd 16 -dlt 2048 -single -ftz 0"
+    # Vector mode
+    "-es 1 -mcd 16 -single -ftz 0 -vec -vs 8"
+    "-es 1 -mcd 16 -single -ftz 0 -vec -vs 16"
+    "-es 1 -mcd 16 -single -ftz 0 -vec -vs 32"
+    # Denormal handling
+    "-es 1 -mcd 16 -single -ftz 1"
+    "-es 1 -mcd 16 -single -ftz 2"
+    # Fast (approximate) maths
+    "-es 1 -mcd 16 -single -ftz 0 -fm def"
+  )
+fi
+
+fastmath="$(faust --archdir)/faust/dsp/fastmath.cpp"
+
+echo "| Options | ns/sample | ticks/sample | DSP object (bytes) | host text, with harness (bytes) | Teensy text, with harness (bytes) |"
+echo "|---|---|---|---|---|---|"
+for i in "${!configs[@]}"; do
+  options=${configs[$i]}
+  header="$work/mydsp$i.h"
+  # No architecture file: just the class; the harness supplies the rest.
+  if ! faust -lang cpp -cn mydsp $options "$dsp" -o "$header" 2>"$work/faust$i.log"; then
+    echo "| \`$options\` | faust failed: $(head -n 1 "$work/faust$i.log") | | | | |"
+    continue
+  fi
+
+  extra=()
+  if [[ $options == *-fm* ]]; then
+    extra+=("$fastmath")
+  fi
+
+  flags=(-std=gnu++14 -I"$rootDir/src/WFS" -DMYDSP_HEADER="\"$header\"" -DAUDIO_BLOCK_SAMPLES="$BLOCK_SIZE")
+  if ! $CXX $CXXFLAGS "${flags[@]}" "$scriptDir/bench/dsp_bench.cpp" "$rootDir/src/WFS/ParamTable.cpp" \
+    "${extra[@]}" -o "$work/bench$i" 2>"$work/build$i.log"; then
+    echo "| \`$options\` | build failed: $(grep -m 1 error "$work/build$i.log") | | | | |"
+    continue
+  fi
+
+  result=$("$work/bench$i" "$BLOCKS")
+  nsPerSample=$(sed -n 's/.*ns_per_sample=\([^ ]*\).*/\1/p' <<<"$result")
+  ticksPerSample=$(sed -n 's/.*ticks_per_sample=\([^ ]*\).*/\1/p' <<<"$result")
+  dspBytes=$(sed -n 's/.*dsp_bytes=\([^ ]*\).*/\1/p' <<<"$result")
+
+  # Code size of the class alone.
+  $CXX $CXXFLAGS "${flags[@]}" -c "$scriptDir/bench/dsp_bench.cpp" -o "$work/bench$i.o"
+  hostText=$(size "$work/bench$i.o" | awk 'NR == 2 { print $1 }')
+
+  teensyText=""
+  if [ -n "$ARM_CXX" ]; then
+    # As PlatformIO builds for the Teensy 4.1.
+    if $ARM_CXX -O2 -mcpu=cortex-m7 -mfloat-abi=hard -mfpu=fpv5-d16 -mthumb -fno-exceptions -fno-rtti \
+      "${flags[@]}" -c "$scriptDir/bench/dsp_bench.cpp" -o "$work/arm$i.o" 2>/dev/null; then
+      teensyText=$("${ARM_CXX%g++}size" "$work/arm$i.o" | awk 'NR == 2 { print $1 }')
+    fi
+  fi
+
+  echo "| \`$options\` | $nsPerSample | $ticksPerSample | $dspBytes | $hostText | $teensyText |"
+done
@@ -0,0 +1,51 @@
+#include "ClockSync.h"
+#include <algorithm>
+
+ClockSync::ClockSync(float sampleRate, float latency, float window) :
+        sampleRate(sampleRate),
+        latency(static_cast<int64_t>(latency * sampleRate)),
+        window(static_cast<int64_t>(window * sampleRate)) {}
+
+void ClockSync::observe(uint64_t timetag, uint64_t arrival) {
+    if (timetag <= kImmediately) {
+        return;
+    }
+    auto difference{static_cast<int64_t>(arrival) - toSamples(timetag)};
+    if (!synchronised) {
+        synchronised = true;
+        windowStart = arrival;
+        currentMin = previousMin = difference;
+        return;
+    }
+    // Keep the last full window's minimum, so that the estimate doesn't jump
+    // when a new window starts.
+    if (static_cast<int64_t>(arrival - windowStart) >= window) {
+        previousMin = currentMin;
+        currentMin = difference;
+        windowStart = arrival;
+    } else {
+        currentMin = std::min(currentMin, difference);
+    }
+}
+
+uint64_t ClockSync::schedule(uint64_t timetag) const {
+    if (timetag <= kImmediately || !synchronised) {
+        return 0;
+    }
+    auto time{toSamples(timetag) + getOffset() + latency};
+    return time > 0 ? static_cast<uint64_t>(time) : 0;
+}
+
+bool ClockSync::isSynchronised() const {
+    return synchronised;
+}
+
+int64_t ClockSync::getOffset() const {
+    return std::min(currentMin, previousMin);
+}
+
+int64_t ClockSync::toSamples(uint64_t timetag) const {
+    auto seconds{static_cast<double>(timetag >> 32)};
+    auto fraction{static_cast<double>(timetag & 0xffffffffu) / 4294967296.};
+    return static_cast<int64_t>((seconds + fraction) * sampleRate);
+}
@@ -0,0 +1,65 @@
+#ifndef TEENSY_WFS_CLOCKSYNC_H
+#define TEENSY_WFS_CLOCKSYNC_H
+
+#include <cstdint>
+
+/**
+ * Maps the controller's clock, as given by OSC bundle timetags, onto this
+ * node's sample clock (see WFS::getSampleTime()), so that every node can
+ * apply a bundle at the same moment.
+ *
+ * The controller stamps each bundle with the time it was sent. The offset
+ * between the two clocks is estimated as the smallest difference between a
+ * bundle's arrival time and its timetag over the last couple of windows; that
+ * is, the clock offset plus the network's minimum latency, which is much the
+ * same for every node on the switch. A bundle is then applied a fixed
+ * latency after its timetag, by which time it should have reached every
+ * node. The windowing lets the estimate follow drift between the two clocks.
+ */
+class ClockSync {
+public:
+    // OSC's "immediately".
+    static constexpr uint64_t kImmediately{1};
+
+    /**
+     * @param latency Seconds from a bundle's timetag to its application.
+     * @param window Seconds over which to take each minimum.
+     */
+    ClockSync(float sampleRate, float latency, float window);
+
+    /**
+     * Record a bundle's arrival, in samples on this node's clock.
+     */
+    void observe(uint64_t timetag, uint64_t arrival);
+
+    /**
+     * @return The time on this node's sample clock at which to apply a bundle
+     * with the given timetag, or 0 to apply it now (if the timetag is
+     * "immediately", or there's no estimate of the offset yet).
+     */
+    uint64_t schedule(uint64_t timetag) const;
+
+    bool isSynchronised() const;
+
+    /**
+     * Local sample time minus controller time, in samples.
+     */
+    int64_t getOffset() const;
+
+private:
+    /**
+     * An NTP-format timetag (seconds since 1900, in 32.32 fixed point) in
+     * samples.
+     */
+    int64_t toSamples(uint64_t timetag) const;
+
+    double sampleRate;
+    int64_t latency;
+    int64_t window;
+
+    bool synchronised{false};
+    uint64_t windowStart{0};
+    int64_t currentMin{0}, previousMin{0};
+};
+
+#endif //TEENSY_WFS_CLOCKSYNC_H
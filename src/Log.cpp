@@ -0,0 +1,52 @@
+#include "Log.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+SPSCQueue<Log::Record, Log::kCapacity> Log::records;
+Log::Record Log::current{};
+int Log::currentOffset{0};
+uint32_t Log::dropped{0};
+
+void Log::write(const char *format, ...) {
+    Record record;
+    va_list args;
+    va_start(args, format);
+    auto length{vsnprintf(record.text, kMaxLength, format, args)};
+    va_end(args);
+    if (length < 0) {
+        return;
+    }
+    // Keep the line break on a truncated message.
+    if (length >= kMaxLength) {
+        length = kMaxLength - 1;
+        record.text[length - 1] = '\n';
+    }
+    record.length = static_cast<uint16_t>(length);
+    if (!records.push(record)) {
+        dropped++;
+    }
+}
+
+void Log::drain() {
+    while (true) {
+        if (currentOffset >= current.length) {
+            if (!records.pop(current)) {
+                return;
+            }
+            currentOffset = 0;
+        }
+        auto available{Serial.availableForWrite()};
+        if (available <= 0) {
+            return;
+        }
+        auto count{std::min(available, current.length - currentOffset)};
+        Serial.write(reinterpret_cast<const uint8_t *>(current.text + currentOffset), count);
+        currentOffset += count;
+    }
+}
+
+uint32_t Log::getDropped() {
+    return dropped;
+}
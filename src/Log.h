@@ -0,0 +1,86 @@
+#ifndef TEENSY_WFS_LOG_H
+#define TEENSY_WFS_LOG_H
+
+#include <cstdint>
+#include "WFS/SPSCQueue.h"
+
+// Messages above WFS_LOG_LEVEL are compiled out; e.g. build with
+// -DWFS_LOG_LEVEL=4 to see every parameter change.
+#define WFS_LOG_LEVEL_NONE 0
+#define WFS_LOG_LEVEL_ERROR 1
+#define WFS_LOG_LEVEL_WARN 2
+#define WFS_LOG_LEVEL_INFO 3
+#define WFS_LOG_LEVEL_DEBUG 4
+
+#ifndef WFS_LOG_LEVEL
+#define WFS_LOG_LEVEL WFS_LOG_LEVEL_INFO
+#endif
+
+#if WFS_LOG_LEVEL >= WFS_LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Log::write(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (false)
+#endif
+
+#if WFS_LOG_LEVEL >= WFS_LOG_LEVEL_WARN
+#define LOG_WARN(...) Log::write(__VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (false)
+#endif
+
+#if WFS_LOG_LEVEL >= WFS_LOG_LEVEL_INFO
+#define LOG_INFO(...) Log::write(__VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (false)
+#endif
+
+#if WFS_LOG_LEVEL >= WFS_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Log::write(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (false)
+#endif
+
+/**
+ * Deferred serial logging, so that loop() never waits on the USB serial port.
+ * A message is formatted at the call, and queued; drain() writes out as much
+ * as the port will take without blocking. When the queue is full, messages
+ * are dropped, and counted, rather than waited on.
+ *
+ * Messages are formatted straight away because their arguments (e.g. an OSC
+ * address copied to the stack) may not outlive the call.
+ *
+ * Log from loop() only, not from interrupts; the queue has a single producer.
+ */
+class Log {
+public:
+    // Longer messages are truncated.
+    static constexpr int kMaxLength{124};
+    static constexpr uint32_t kCapacity{32};
+
+    static void write(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+    /**
+     * Write queued messages to serial, for as long as it has room. Call from
+     * loop().
+     */
+    static void drain();
+
+    /**
+     * @return Messages dropped, since startup, for want of room in the queue.
+     */
+    static uint32_t getDropped();
+
+private:
+    struct Record {
+        uint16_t length;
+        char text[kMaxLength];
+    };
+
+    static SPSCQueue<Record, kCapacity> records;
+    // The record being written out, and how much of it has been.
+    static Record current;
+    static int currentOffset;
+    static uint32_t dropped;
+};
+
+#endif //TEENSY_WFS_LOG_H
@@ -0,0 +1,228 @@
+#include "OscReader.h"
+#include <cstring>
+
+namespace {
+
+const char kBundleTag[]{"#bundle"};
+constexpr int kBundleHeaderSize{16};
+
+uint32_t readBigEndian32(const uint8_t *data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+/**
+ * @return The size of an argument of the given type, or -1 if the type isn't
+ * known or the argument doesn't fit in size.
+ */
+int getArgumentSize(char type, const uint8_t *data, int size) {
+    switch (type) {
+        case 'i':
+        case 'f':
+        case 'c':
+        case 'r':
+        case 'm':
+            return size >= 4 ? 4 : -1;
+        case 'h':
+        case 't':
+        case 'd':
+            return size >= 8 ? 8 : -1;
+        case 's':
+        case 'S': {
+            for (int i{0}; i < size; ++i) {
+                if (data[i] == 0) {
+                    auto padded{(i + 4) & ~3};
+                    return padded <= size ? padded : -1;
+                }
+            }
+            return -1;
+        }
+        case 'b': {
+            if (size < 4) {
+                return -1;
+            }
+            auto length{readBigEndian32(data)};
+            if (length > static_cast<uint32_t>(size - 4)) {
+                return -1;
+            }
+            auto padded{4 + ((static_cast<int>(length) + 3) & ~3)};
+            return padded <= size ? padded : -1;
+        }
+        case 'T':
+        case 'F':
+        case 'N':
+        case 'I':
+        case '[':
+        case ']':
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+}
+
+const char *OscReader::Message::getAddress() const {
+    return address;
+}
+
+int OscReader::Message::size() const {
+    return numArguments;
+}
+
+char OscReader::Message::getType(int index) const {
+    return index >= 0 && index < numArguments ? types[index] : 0;
+}
+
+float OscReader::Message::getFloat(int index) const {
+    switch (getType(index)) {
+        case 'f': {
+            auto bits{readBigEndian32(arguments[index])};
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case 'i':
+            return static_cast<float>(getInt(index));
+        default:
+            return 0.f;
+    }
+}
+
+int32_t OscReader::Message::getInt(int index) const {
+    return getType(index) == 'i' ? static_cast<int32_t>(readBigEndian32(arguments[index])) : 0;
+}
+
+const char *OscReader::Message::getString(int index) const {
+    return getType(index) == 's' ? reinterpret_cast<const char *>(arguments[index]) : nullptr;
+}
+
+const char *OscReader::Message::match(const char *prefix) const {
+    auto length{strlen(prefix)};
+    if (strncmp(address, prefix, length) != 0) {
+        return nullptr;
+    }
+    switch (address[length]) {
+        case '\0':
+            return address + length;
+        case '/':
+            return address + length + 1;
+        default:
+            return nullptr;
+    }
+}
+
+bool OscReader::read(const uint8_t *packet, int packetSize) {
+    buffer = packet;
+    size = packetSize;
+    position = 0;
+    bundle = false;
+    timetag = 1;
+    error = false;
+
+    if (size >= kBundleHeaderSize && memcmp(buffer, kBundleTag, sizeof(kBundleTag)) == 0) {
+        bundle = true;
+        timetag = (static_cast<uint64_t>(readBigEndian32(buffer + 8)) << 32) | readBigEndian32(buffer + 12);
+        position = kBundleHeaderSize;
+    } else if (size < 4 || buffer[0] != '/' || size % 4 != 0) {
+        error = true;
+        position = size;
+    }
+    return !error;
+}
+
+bool OscReader::isBundle() const {
+    return bundle;
+}
+
+uint64_t OscReader::getTimetag() const {
+    return timetag;
+}
+
+bool OscReader::next(Message &message) {
+    if (!bundle) {
+        if (position >= size) {
+            return false;
+        }
+        position = size;
+        error = !readMessage(buffer, size, message);
+        return !error;
+    }
+
+    while (position < size) {
+        // Each element is its size, then a message or a bundle. If the size
+        // is wrong, so is everything after it.
+        if (size - position < 4) {
+            error = true;
+            return false;
+        }
+        auto elementSize{readBigEndian32(buffer + position)};
+        position += 4;
+        if (elementSize > static_cast<uint32_t>(size - position) || elementSize % 4 != 0) {
+            error = true;
+            position = size;
+            return false;
+        }
+        auto element{buffer + position};
+        position += static_cast<int>(elementSize);
+        if (readMessage(element, static_cast<int>(elementSize), message)) {
+            return true;
+        }
+        // A malformed message, or a nested bundle; skip it, and read on.
+        error = true;
+    }
+    return false;
+}
+
+bool OscReader::hasError() const {
+    return error;
+}
+
+bool OscReader::readMessage(const uint8_t *data, int size, Message &message) {
+    if (size < 4 || data[0] != '/') {
+        return false;
+    }
+    auto addressSize{getArgumentSize('s', data, size)};
+    if (addressSize < 0) {
+        return false;
+    }
+    auto address{reinterpret_cast<const char *>(data)};
+
+    // Type tags are optional, in principle; a message without has no
+    // arguments.
+    auto offset{addressSize};
+    if (offset == size) {
+        message.address = address;
+        message.types = "";
+        message.numArguments = 0;
+        return true;
+    }
+    if (data[offset] != ',') {
+        return false;
+    }
+    auto typesSize{getArgumentSize('s', data + offset, size - offset)};
+    if (typesSize < 0) {
+        return false;
+    }
+    auto types{reinterpret_cast<const char *>(data + offset + 1)};
+    offset += typesSize;
+
+    const uint8_t *arguments[kMaxArguments];
+    int numArguments{0};
+    for (int i{0}; types[i] != '\0'; ++i) {
+        auto argumentSize{getArgumentSize(types[i], data + offset, size - offset)};
+        if (argumentSize < 0) {
+            return false;
+        }
+        if (i < kMaxArguments) {
+            arguments[numArguments++] = data + offset;
+        }
+        offset += argumentSize;
+    }
+
+    message.address = address;
+    message.types = types;
+    memcpy(message.arguments, arguments, numArguments * sizeof(arguments[0]));
+    message.numArguments = numArguments;
+    return true;
+}
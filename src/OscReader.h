@@ -0,0 +1,105 @@
+#ifndef TEENSY_WFS_OSCREADER_H
+#define TEENSY_WFS_OSCREADER_H
+
+#include <cstdint>
+
+/**
+ * Reads OSC 1.0 packets in place, without allocating: messages' addresses and
+ * string arguments point into the packet, so are only valid while it is.
+ *
+ * Arguments of type f, i and s can be read; the other standard types (b, h,
+ * t, d, and those without data) are skipped over. Nested bundles are skipped,
+ * and counted as errors.
+ */
+class OscReader {
+public:
+    // Arguments beyond this many are ignored.
+    static constexpr int kMaxArguments{8};
+
+    class Message {
+    public:
+        const char *getAddress() const;
+
+        /**
+         * @return The number of arguments, up to kMaxArguments.
+         */
+        int size() const;
+
+        /**
+         * @return The argument's type tag, or 0 if there's no such argument.
+         */
+        char getType(int index) const;
+
+        /**
+         * @return An f argument, or an i argument converted; otherwise 0.
+         */
+        float getFloat(int index) const;
+
+        /**
+         * @return An i argument; otherwise 0.
+         */
+        int32_t getInt(int index) const;
+
+        /**
+         * @return An s argument, or nullptr.
+         */
+        const char *getString(int index) const;
+
+        /**
+         * Matches the start of the address against prefix, by whole parts,
+         * e.g. "/source" matches "/source/0/x", but not "/sources".
+         *
+         * @return What follows prefix and a '/' ("0/x"; "" if nothing does),
+         * or nullptr if the address doesn't start with prefix.
+         */
+        const char *match(const char *prefix) const;
+
+    private:
+        friend class OscReader;
+
+        const char *address{""};
+        // Type tags, without the leading ','.
+        const char *types{""};
+        const uint8_t *arguments[kMaxArguments]{};
+        int numArguments{0};
+    };
+
+    /**
+     * Starts reading a packet, which must outlive the reader's use of it.
+     *
+     * @return Whether the packet starts as a message or bundle should.
+     */
+    bool read(const uint8_t *buffer, int size);
+
+    bool isBundle() const;
+
+    /**
+     * @return The bundle's timetag, or 1 ("immediately") for a message.
+     */
+    uint64_t getTimetag() const;
+
+    /**
+     * Reads the packet's message, or the bundle's next.
+     *
+     * @return Whether there was another well-formed message to read.
+     */
+    bool next(Message &message);
+
+    /**
+     * @return Whether read() or next() met anything malformed or unsupported.
+     */
+    bool hasError() const;
+
+private:
+    static bool readMessage(const uint8_t *data, int size, Message &message);
+
+    const uint8_t *buffer{nullptr};
+    int size{0};
+    // Where the next message, or bundle element, starts.
+    int position{0};
+    bool bundle{false};
+    uint64_t timetag{1};
+    bool error{false};
+};
+
+#endif //TEENSY_WFS_OSCREADER_H
@@ -0,0 +1,19 @@
+#include "PatchGraph.h"
+
+void PatchGraph::connect(AudioStream &source, unsigned char output, AudioStream &destination, unsigned char input) {
+    connections.push_back(std::make_unique<AudioConnection>(source, output, destination, input));
+    for (const auto &o: outputs) {
+        if (o.source == &source && o.index == output) {
+            return;
+        }
+    }
+    outputs.push_back({&source, output});
+}
+
+void PatchGraph::addHeldBlocks(int blocks) {
+    heldBlocks += blocks;
+}
+
+int PatchGraph::getRequiredBlocks() const {
+    return static_cast<int>(outputs.size()) * kBlocksPerOutput + heldBlocks + kSpareBlocks;
+}
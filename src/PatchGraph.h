@@ -0,0 +1,52 @@
+#ifndef TEENSY_WFS_PATCHGRAPH_H
+#define TEENSY_WFS_PATCHGRAPH_H
+
+#include <Audio.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Makes, and keeps, the audio library connections between objects, so that
+ * the number of audio blocks the graph needs can be worked out from it,
+ * rather than guessed.
+ *
+ * Each connected output holds at most two blocks at once: the one it has just
+ * transmitted and, if a destination updates earlier in the cycle than its
+ * source (e.g. JackTripClient's loopback to itself), the previous one, still
+ * queued. Blocks are reference counted, so fanning an output out to several
+ * inputs costs nothing extra. Some objects also keep blocks between updates
+ * (e.g. AudioOutputI2S double-buffers each channel); declare those with
+ * addHeldBlocks().
+ */
+class PatchGraph {
+public:
+    static constexpr int kBlocksPerOutput{2};
+    // Headroom for objects that briefly hold an extra block during update().
+    static constexpr int kSpareBlocks{4};
+
+    void connect(AudioStream &source, unsigned char output, AudioStream &destination, unsigned char input);
+
+    /**
+     * Declare blocks held by an object between updates, besides those
+     * accounted for by its connections.
+     */
+    void addHeldBlocks(int blocks);
+
+    /**
+     * @return The number of blocks the audio memory pool needs.
+     */
+    int getRequiredBlocks() const;
+
+private:
+    struct Output {
+        const AudioStream *source;
+        unsigned char index;
+    };
+
+    std::vector<std::unique_ptr<AudioConnection>> connections;
+    // Distinct connected outputs.
+    std::vector<Output> outputs;
+    int heldBlocks{0};
+};
+
+#endif //TEENSY_WFS_PATCHGRAPH_H
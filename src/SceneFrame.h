@@ -0,0 +1,130 @@
+#ifndef TEENSY_WFS_SCENEFRAME_H
+#define TEENSY_WFS_SCENEFRAME_H
+
+#include <cstdint>
+
+/**
+ * Every source's position in one datagram, as an alternative to an OSC
+ * message per co-ordinate. Shared by the node firmware and the controller, so
+ * kept free of either's dependencies.
+ *
+ * Layout, big-endian, as OSC:
+ *
+ *   0   "WFSF"
+ *   4   version
+ *   5   number of sources, n
+ *   6   reserved, 0
+ *   8   session, chosen at random each time the controller starts
+ *   12  sequence number, incremented per frame
+ *   16  timetag, as an OSC bundle's
+ *   24  valid mask: bit i set if source i has a position
+ *   32  changed mask: bit i set if source i has moved since the last frame
+ *   40  n * (x, y), each 0-1 quantised to 16 bits; (0, 0) if not valid
+ *
+ * Every frame carries every valid position, so a receiver that has missed
+ * frames, or joined a new session, can apply them all; otherwise, only the
+ * changed ones need applying.
+ *
+ * The magic can't be mistaken for an OSC packet, which starts with '/' or '#'.
+ */
+struct SceneFrame {
+    static constexpr uint8_t kVersion{2};
+    static constexpr int kHeaderSize{40};
+    static constexpr int kMaxSources{64};
+    static constexpr int kMaxSize{kHeaderSize + 4 * kMaxSources};
+
+    uint32_t session{0};
+    uint32_t sequence{0};
+    uint64_t timetag{0};
+    uint64_t valid{0};
+    uint64_t changed{0};
+    int numSources{0};
+    // Co-ordinates, 0-1, as WFS.dsp's.
+    float x[kMaxSources]{}, y[kMaxSources]{};
+
+    static constexpr uint64_t bit(int source) {
+        return uint64_t{1} << source;
+    }
+
+    static constexpr int getSize(int numSources) {
+        return kHeaderSize + 4 * numSources;
+    }
+
+    static bool isFrame(const uint8_t *buffer, int size) {
+        return size >= kHeaderSize &&
+               buffer[0] == 'W' && buffer[1] == 'F' && buffer[2] == 'S' && buffer[3] == 'F';
+    }
+
+    /**
+     * @return The number of bytes written, or 0 if they wouldn't fit.
+     */
+    int encode(uint8_t *buffer, int size) const {
+        if (numSources < 0 || numSources > kMaxSources || size < getSize(numSources)) {
+            return 0;
+        }
+        buffer[0] = 'W';
+        buffer[1] = 'F';
+        buffer[2] = 'S';
+        buffer[3] = 'F';
+        buffer[4] = kVersion;
+        buffer[5] = static_cast<uint8_t>(numSources);
+        buffer[6] = buffer[7] = 0;
+        write(buffer + 8, session, 4);
+        write(buffer + 12, sequence, 4);
+        write(buffer + 16, timetag, 8);
+        write(buffer + 24, valid, 8);
+        write(buffer + 32, changed, 8);
+        for (int i{0}; i < numSources; ++i) {
+            write(buffer + kHeaderSize + 4 * i, quantise(x[i]), 2);
+            write(buffer + kHeaderSize + 4 * i + 2, quantise(y[i]), 2);
+        }
+        return getSize(numSources);
+    }
+
+    /**
+     * @return Whether buffer holds a complete frame of this version.
+     */
+    bool decode(const uint8_t *buffer, int size) {
+        if (!isFrame(buffer, size) || buffer[4] != kVersion || buffer[5] > kMaxSources ||
+            size < getSize(buffer[5])) {
+            return false;
+        }
+        numSources = buffer[5];
+        session = static_cast<uint32_t>(read(buffer + 8, 4));
+        sequence = static_cast<uint32_t>(read(buffer + 12, 4));
+        timetag = read(buffer + 16, 8);
+        valid = read(buffer + 24, 8);
+        changed = read(buffer + 32, 8);
+        for (int i{0}; i < numSources; ++i) {
+            x[i] = dequantise(read(buffer + kHeaderSize + 4 * i, 2));
+            y[i] = dequantise(read(buffer + kHeaderSize + 4 * i + 2, 2));
+        }
+        return true;
+    }
+
+private:
+    static uint64_t quantise(float value) {
+        value = value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+        return static_cast<uint64_t>(value * 65535.f + .5f);
+    }
+
+    static float dequantise(uint64_t value) {
+        return static_cast<float>(value) * (1.f / 65535.f);
+    }
+
+    static void write(uint8_t *buffer, uint64_t value, int bytes) {
+        for (int i{bytes - 1}; i >= 0; --i, value >>= 8) {
+            buffer[i] = static_cast<uint8_t>(value);
+        }
+    }
+
+    static uint64_t read(const uint8_t *buffer, int bytes) {
+        uint64_t value{0};
+        for (int i{0}; i < bytes; ++i) {
+            value = (value << 8) | buffer[i];
+        }
+        return value;
+    }
+};
+
+#endif //TEENSY_WFS_SCENEFRAME_H
@@ -0,0 +1,67 @@
+#include "Arena.h"
+#include <Arduino.h>
+
+Arena::Arena(uint8_t *memory, size_t size, const char *region) :
+        memory(memory),
+        size(size),
+        region(region) {}
+
+void *Arena::allocate(size_t bytes, const char *label) {
+    auto offset{footprint(used)};
+    if (offset + bytes > size) {
+        return nullptr;
+    }
+    used = offset + bytes;
+    if (numAllocations < kMaxAllocations) {
+        allocations[numAllocations++] = {label, bytes};
+    }
+    return memory + offset;
+}
+
+size_t Arena::getUsed() const {
+    return used;
+}
+
+size_t Arena::getSize() const {
+    return size;
+}
+
+const char *Arena::getRegion() const {
+    return region;
+}
+
+void Arena::printReport() const {
+    Serial.printf("WFS arena: %u of %u bytes in %s, at %p\n",
+                  static_cast<unsigned>(used), static_cast<unsigned>(size), region, memory);
+    for (int i{0}; i < numAllocations; ++i) {
+        Serial.printf("  %-16s %u bytes\n", allocations[i].label, static_cast<unsigned>(allocations[i].size));
+    }
+}
+
+#ifdef __IMXRT1062__
+extern "C" {
+extern unsigned long _stext, _etext, _sdata, _ebss, _heap_start, _heap_end, _itcm_block_count;
+extern unsigned long _extram_start, _extram_end;
+extern char *__brkval;
+extern uint8_t external_psram_size;
+}
+#endif
+
+void Arena::printRegionReport() {
+#ifdef __IMXRT1062__
+    constexpr unsigned kRAM1Size{512 * 1024}, kRAM2Start{0x20200000}, kITCMBlockSize{32 * 1024};
+    auto itcmSize{reinterpret_cast<unsigned>(&_itcm_block_count) * kITCMBlockSize};
+    auto itcmUsed{reinterpret_cast<unsigned>(&_etext) - reinterpret_cast<unsigned>(&_stext)};
+    // DTCM's remaining space is shared with the stack.
+    auto dtcmUsed{reinterpret_cast<unsigned>(&_ebss) - reinterpret_cast<unsigned>(&_sdata)};
+    auto ram2Static{reinterpret_cast<unsigned>(&_heap_start) - kRAM2Start};
+    auto ram2Heap{reinterpret_cast<unsigned>(__brkval) - reinterpret_cast<unsigned>(&_heap_start)};
+    auto ram2Size{reinterpret_cast<unsigned>(&_heap_end) - kRAM2Start};
+    Serial.printf("RAM1: ITCM (code) %u of %u bytes; DTCM (data) %u of %u bytes\n",
+                  itcmUsed, itcmSize, dtcmUsed, kRAM1Size - itcmSize);
+    Serial.printf("RAM2: DMAMEM %u bytes, heap %u bytes, of %u bytes\n", ram2Static, ram2Heap, ram2Size);
+    Serial.printf("EXTMEM: %u of %u bytes\n",
+                  reinterpret_cast<unsigned>(&_extram_end) - reinterpret_cast<unsigned>(&_extram_start),
+                  external_psram_size * 1024u * 1024u);
+#endif
+}
@@ -0,0 +1,101 @@
+#ifndef TEENSY_WFS_ARENA_H
+#define TEENSY_WFS_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Memory region holding the WFS object's DSP state; see WFS.cpp. Build with
+// one of WFS_ARENA_DMAMEM or WFS_ARENA_EXTMEM defined to move it out of DTCM.
+#if defined(WFS_ARENA_EXTMEM)
+#define WFS_ARENA_SECTION EXTMEM
+#define WFS_ARENA_REGION "EXTMEM"
+#elif defined(WFS_ARENA_DMAMEM)
+#define WFS_ARENA_SECTION DMAMEM
+#define WFS_ARENA_REGION "DMAMEM"
+#else
+#define WFS_ARENA_SECTION
+#define WFS_ARENA_REGION "DTCM"
+#endif
+
+/**
+ * Bump allocator over a fixed block of memory, so that related state can be
+ * kept together, in a region of the caller's choosing. Nothing is freed
+ * individually; objects created in the arena must be destroyed by the caller.
+ *
+ * Allocations are labelled, for printReport().
+ */
+class Arena {
+public:
+    // The Cortex-M7's cache line.
+    static constexpr size_t kAlignment{32};
+    static constexpr int kMaxAllocations{8};
+
+    /**
+     * @param memory At least kAlignment-aligned.
+     */
+    Arena(uint8_t *memory, size_t size, const char *region);
+
+    /**
+     * @return Uninitialised memory, aligned to kAlignment, or nullptr if the
+     * arena is full.
+     */
+    void *allocate(size_t bytes, const char *label);
+
+    template<class T, class... Args>
+    T *create(const char *label, Args &&... args) {
+        auto *memory{allocate(sizeof(T), label)};
+        return memory ? new(memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template<class T>
+    T *createArray(size_t count, const char *label) {
+        auto *array{static_cast<T *>(allocate(count * sizeof(T), label))};
+        if (array) {
+            for (size_t i{0}; i < count; ++i) {
+                new(array + i) T();
+            }
+        }
+        return array;
+    }
+
+    size_t getUsed() const;
+
+    size_t getSize() const;
+
+    const char *getRegion() const;
+
+    /**
+     * Number of bytes an allocation of size occupies in the arena.
+     */
+    static constexpr size_t footprint(size_t size) {
+        return (size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    /**
+     * Print the arena's region and usage, and each allocation, to serial.
+     */
+    void printReport() const;
+
+    /**
+     * Print the bytes in use in each of the Teensy 4's memory regions (RAM1's
+     * ITCM and DTCM, RAM2 and any PSRAM) to serial.
+     */
+    static void printRegionReport();
+
+private:
+    struct Allocation {
+        const char *label;
+        size_t size;
+    };
+
+    uint8_t *memory;
+    size_t size;
+    size_t used{0};
+    const char *region;
+    Allocation allocations[kMaxAllocations]{};
+    int numAllocations{0};
+};
+
+#endif //TEENSY_WFS_ARENA_H
@@ -0,0 +1,72 @@
+#include "ArrayGeometry.h"
+#include <EEPROM.h>
+#include <cmath>
+
+// Identifies a stored geometry table; includes the speaker count so that
+// changing NUM_SPEAKERS invalidates whatever was stored previously.
+static constexpr uint32_t kStorageMagic{0x47450000 | ArrayGeometry::kNumSpeakers};
+
+ArrayGeometry::ArrayGeometry() {
+    reset();
+}
+
+void ArrayGeometry::setSpeaker(int index, const Speaker &speaker) {
+    if (index < 0 || index >= kNumSpeakers) {
+        return;
+    }
+    auto norm{sqrtf(speaker.nx * speaker.nx + speaker.ny * speaker.ny)};
+    if (norm == 0.f) {
+        return;
+    }
+    speakers[index] = {speaker.x, speaker.y, speaker.nx / norm, speaker.ny / norm};
+}
+
+const ArrayGeometry::Speaker &ArrayGeometry::getSpeaker(int index) const {
+    return speakers[index];
+}
+
+void ArrayGeometry::reset() {
+    for (int i{0}; i < kNumSpeakers; ++i) {
+        speakers[i] = {SPEAKER_DIST * static_cast<float>(i), 0.f, 0.f, -1.f};
+    }
+}
+
+float ArrayGeometry::getSpacing(int index) const {
+    auto distance = [this](int a, int b) {
+        auto dx{speakers[a].x - speakers[b].x}, dy{speakers[a].y - speakers[b].y};
+        return sqrtf(dx * dx + dy * dy);
+    };
+
+    if (kNumSpeakers < 2) {
+        return SPEAKER_DIST;
+    } else if (index == 0) {
+        return distance(0, 1);
+    } else if (index == kNumSpeakers - 1) {
+        return distance(index - 1, index);
+    } else {
+        return .5f * (distance(index - 1, index) + distance(index, index + 1));
+    }
+}
+
+bool ArrayGeometry::load(int eepromAddress) {
+    uint32_t magic;
+    EEPROM.get(eepromAddress, magic);
+    if (magic != kStorageMagic) {
+        return false;
+    }
+    eepromAddress += sizeof(magic);
+    for (auto &speaker: speakers) {
+        EEPROM.get(eepromAddress, speaker);
+        eepromAddress += sizeof(Speaker);
+    }
+    return true;
+}
+
+void ArrayGeometry::store(int eepromAddress) const {
+    EEPROM.put(eepromAddress, kStorageMagic);
+    eepromAddress += sizeof(kStorageMagic);
+    for (const auto &speaker: speakers) {
+        EEPROM.put(eepromAddress, speaker);
+        eepromAddress += sizeof(Speaker);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef TEENSY_WFS_ARRAYGEOMETRY_H
+#define TEENSY_WFS_ARRAYGEOMETRY_H
+
+#include <cstdint>
+#include "WFSParams.h"
+
+/**
+ * Positions and orientations of every speaker in the array, in the same
+ * co-ordinate space as the sources (metres; x along the array, y from the
+ * array towards MAX_Y_DIST).
+ *
+ * Defaults to a straight line along y = 0, with speakers SPEAKER_DIST apart
+ * and facing away from the sources, i.e. the geometry assumed by WFS.dsp.
+ * Every module holds the whole table, as delays are computed relative to the
+ * array as a whole.
+ */
+class ArrayGeometry {
+public:
+    /**
+     * A speaker's position, and its normal, pointing into the listening
+     * area.
+     */
+    struct Speaker {
+        float x{0.f}, y{0.f}, nx{0.f}, ny{-1.f};
+    };
+
+    static constexpr int kNumSpeakers{NUM_SPEAKERS};
+
+    ArrayGeometry();
+
+    /**
+     * Set a speaker's position and normal; the normal is normalised here.
+     */
+    void setSpeaker(int index, const Speaker &speaker);
+
+    const Speaker &getSpeaker(int index) const;
+
+    /**
+     * Restore the default, straight-line geometry.
+     */
+    void reset();
+
+    /**
+     * Distance from a speaker to its neighbours in the table (the mean of the
+     * two, or the one neighbour at either end).
+     */
+    float getSpacing(int index) const;
+
+    /**
+     * Read the geometry from EEPROM, if a valid table was stored there.
+     * @return Whether the geometry was loaded.
+     */
+    bool load(int eepromAddress);
+
+    void store(int eepromAddress) const;
+
+    /**
+     * Number of EEPROM bytes occupied by the stored geometry.
+     */
+    static constexpr int kStorageSize{sizeof(uint32_t) + kNumSpeakers * sizeof(Speaker)};
+
+private:
+    Speaker speakers[kNumSpeakers];
+};
+
+#endif //TEENSY_WFS_ARRAYGEOMETRY_H
@@ -0,0 +1,64 @@
+#ifndef TEENSY_WFS_FLUSHTOZERO_H
+#define TEENSY_WFS_FLUSHTOZERO_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Helpers for keeping subnormal floats out of recursive filter states, which
+ * are slow to process when the FPU isn't flushing them to zero.
+ */
+namespace wfs {
+// Filter states below this magnitude (-300 dBFS) are inaudible; zeroing them
+// at block boundaries stops a silent source's filters decaying through the
+// subnormal range.
+constexpr float kFlushThreshold{1e-15f};
+
+// Build with WFS_NO_STATE_FLUSH defined to leave filter states alone, e.g. to
+// measure what flushing saves; see scripts/bench/silent_tail_bench.cpp.
+inline float flushTiny(float value) {
+#ifdef WFS_NO_STATE_FLUSH
+    return value;
+#else
+    return fabsf(value) < kFlushThreshold ? 0.f : value;
+#endif
+}
+
+#if defined(__arm__) && defined(__ARM_FP)
+// FPSCR flag bits; see the ARMv7-M Architecture Reference Manual, A2.5.3.
+constexpr uint32_t kFPSCRFlushToZero{1u << 24};
+constexpr uint32_t kFPSCRInputDenormal{1u << 7};
+constexpr uint32_t kFPSCRUnderflow{1u << 3};
+
+/**
+ * Set flush-to-zero mode for the calling context. FPSCR is saved and
+ * restored with the rest of the FPU context on exception entry/return, so
+ * calling this from the audio update affects only the audio update.
+ */
+inline void enableFlushToZero() {
+    uint32_t fpscr;
+    asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+    fpscr |= kFPSCRFlushToZero;
+    asm volatile("vmsr fpscr, %0" : : "r"(fpscr));
+}
+
+/**
+ * @return Whether any subnormal operand or result was encountered since the
+ * previous call (via FPSCR's cumulative input-denormal and underflow flags).
+ */
+inline bool readAndClearDenormalFlags() {
+    uint32_t fpscr;
+    asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+    auto flagged{(fpscr & (kFPSCRInputDenormal | kFPSCRUnderflow)) != 0};
+    fpscr &= ~(kFPSCRInputDenormal | kFPSCRUnderflow);
+    asm volatile("vmsr fpscr, %0" : : "r"(fpscr));
+    return flagged;
+}
+#else
+inline void enableFlushToZero() {}
+
+inline bool readAndClearDenormalFlags() { return false; }
+#endif
+}
+
+#endif //TEENSY_WFS_FLUSHTOZERO_H
@@ -0,0 +1,34 @@
+#include "ParamTable.h"
+#include <cstring>
+
+int ParamTable::getIndex(const char *label) const {
+    for (int i{0}; i < numParams; ++i) {
+        if (strcmp(params[i].label, label) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int ParamTable::getNumParams() const {
+    return numParams;
+}
+
+const char *ParamTable::getLabel(int index) const {
+    return index >= 0 && index < numParams ? params[index].label : "";
+}
+
+float *ParamTable::getZone(int index) const {
+    return index >= 0 && index < numParams ? params[index].zone : nullptr;
+}
+
+void ParamTable::add(const char *label, float *zone) {
+    if (numParams >= kMaxParams) {
+        return;
+    }
+    // Labels may be built in a temporary buffer, so take a copy.
+    auto &param{params[numParams++]};
+    strncpy(param.label, label, kMaxLabelLength - 1);
+    param.label[kMaxLabelLength - 1] = '\0';
+    param.zone = zone;
+}
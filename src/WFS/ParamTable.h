@@ -0,0 +1,87 @@
+#ifndef TEENSY_WFS_PARAMTABLE_H
+#define TEENSY_WFS_PARAMTABLE_H
+
+#include "WFSParams.h"
+
+// Upper bound on the number of parameters a DSP may expose.
+#ifndef WFS_MAX_PARAMS
+#define WFS_MAX_PARAMS (4 * NUM_SOURCES + 16)
+#endif
+
+struct Soundfile;
+
+/**
+ * Fixed-size table of a DSP's parameter zones, filled in by its
+ * buildUserInterface(). Stands in for Faust's UI (see
+ * scripts/arch/teensy-wfs.cpp), without its virtual dispatch, maps, strings
+ * or heap allocation.
+ *
+ * Parameters are addressed by label, e.g. "0/x", or, having looked the label
+ * up once, by index.
+ */
+class ParamTable {
+public:
+    static constexpr int kMaxParams{WFS_MAX_PARAMS};
+    static constexpr int kMaxLabelLength{16};
+
+    //region Faust UI interface
+    void openTabBox(const char *label) {}
+
+    void openHorizontalBox(const char *label) {}
+
+    void openVerticalBox(const char *label) {}
+
+    void closeBox() {}
+
+    void addButton(const char *label, float *zone) { add(label, zone); }
+
+    void addCheckButton(const char *label, float *zone) { add(label, zone); }
+
+    void addVerticalSlider(const char *label, float *zone, float init, float min, float max, float step) {
+        add(label, zone);
+    }
+
+    void addHorizontalSlider(const char *label, float *zone, float init, float min, float max, float step) {
+        add(label, zone);
+    }
+
+    void addNumEntry(const char *label, float *zone, float init, float min, float max, float step) {
+        add(label, zone);
+    }
+
+    void addHorizontalBargraph(const char *label, float *zone, float min, float max) {}
+
+    void addVerticalBargraph(const char *label, float *zone, float min, float max) {}
+
+    void addSoundfile(const char *label, const char *filename, Soundfile **soundfile) {}
+
+    void declare(float *zone, const char *key, const char *value) {}
+    //endregion
+
+    /**
+     * @return The parameter's index, or -1 if there is no such parameter.
+     */
+    int getIndex(const char *label) const;
+
+    int getNumParams() const;
+
+    const char *getLabel(int index) const;
+
+    /**
+     * @return The parameter's zone, or nullptr for an invalid index.
+     */
+    float *getZone(int index) const;
+
+private:
+    struct Param {
+        char label[kMaxLabelLength];
+        float *zone;
+    };
+
+    void add(const char *label, float *zone);
+
+    Param params[kMaxParams]{};
+    int numParams{0};
+};
+
+#endif //TEENSY_WFS_PARAMTABLE_H
@@ -0,0 +1,259 @@
+#ifndef TEENSY_WFS_RENDERCHECK_H
+#define TEENSY_WFS_RENDERCHECK_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "ParamTable.h"
+#include "WFSParams.h"
+
+namespace wfs {
+
+/**
+ * Checks a candidate renderer against a reference (i.e. the Faust-generated
+ * mydsp): both are driven with identical, deterministic input and scripted
+ * source movements, and each speaker's output is compared.
+ *
+ * A run consists of kNumSegments segments, each starting with new source
+ * positions and module ID. After a position change, the renderers' delay
+ * lines hold input filtered for the old positions, which they treat
+ * differently, so the first settleTime of each segment isn't measured.
+ */
+class RenderCheck {
+public:
+    enum class Signal {
+        // One impulse per segment, on one source, at the end of the settling
+        // time.
+        impulse,
+        // Exponential sine sweep, 20 Hz to 20 kHz over the run.
+        sweep,
+        // White noise.
+        noise
+    };
+
+    static constexpr int kNumSignals{3};
+    static constexpr int kNumSegments{8};
+
+    struct Tolerance {
+        float maxError;
+        float minSNR;
+        // Largest permitted difference, in samples, between the positions of
+        // the reference's and candidate's output peaks, for the impulse.
+        int maxLag;
+    };
+
+    struct Result {
+        Signal signal;
+        int speaker;
+        float maxError;
+        // dB; infinite for identical outputs.
+        float snr;
+        int lag;
+        bool passed;
+    };
+
+    static constexpr int kNumResults{kNumSignals * SPEAKERS_PER_MODULE};
+
+    static const char *getSignalName(Signal signal) {
+        switch (signal) {
+            case Signal::impulse:
+                return "impulse";
+            case Signal::sweep:
+                return "sweep";
+            default:
+                return "noise";
+        }
+    }
+
+    /**
+     * Initialises both DSPs at sampleRate, and compares them for each signal.
+     * Parameters already set on the candidate (i.e. its mode) are kept.
+     *
+     * @param results kNumResults entries, by signal then speaker.
+     * @return Whether every result is within tolerance.
+     */
+    template<class Reference, class Candidate>
+    static bool run(Reference &reference, Candidate &candidate, int sampleRate,
+                    const Tolerance &tolerance, Result *results) {
+        ParamTable referenceParams, candidateParams;
+        reference.buildUserInterface(&referenceParams);
+        candidate.buildUserInterface(&candidateParams);
+        reference.init(sampleRate);
+        // Re-initialising would reset the candidate's mode, so just clear it.
+        candidate.instanceConstants(sampleRate);
+        candidate.instanceClear();
+
+        auto passed{true};
+        for (int i{0}; i < kNumSignals; ++i) {
+            auto signal{static_cast<Signal>(i)};
+            reference.instanceClear();
+            candidate.instanceClear();
+            compare(reference, referenceParams, candidate, candidateParams, sampleRate, signal,
+                    tolerance, results + i * SPEAKERS_PER_MODULE);
+            for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+                passed = passed && results[i * SPEAKERS_PER_MODULE + k].passed;
+            }
+        }
+        return passed;
+    }
+
+private:
+    static constexpr int kBlockSize{AUDIO_BLOCK_SAMPLES};
+
+    // A quarter of a second, in whole blocks.
+    static int64_t segmentLengthFor(int sampleRate) {
+        return (sampleRate / 4 / kBlockSize) * kBlockSize;
+    }
+
+    // Enough for the longest delay to flush through.
+    static int64_t settleTimeFor(int sampleRate) {
+        return sampleRate / 20;
+    }
+
+    // Scripted source positions (normalised) and module for each segment;
+    // as WFS.dsp's co-ordinates, 0-1.
+    static void setScene(ParamTable &params, int segment) {
+        char label[ParamTable::kMaxLabelLength];
+        for (int s{0}; s < NUM_SOURCES; ++s) {
+            snprintf(label, sizeof(label), "%d/x", s);
+            setParam(params, label, static_cast<float>((segment * 7 + s * 13) % 100) / 100.f);
+            snprintf(label, sizeof(label), "%d/y", s);
+            setParam(params, label, static_cast<float>((segment * 3 + s * 29) % 100) / 100.f);
+        }
+        setParam(params, "moduleID", static_cast<float>(segment % (NUM_SPEAKERS / SPEAKERS_PER_MODULE)));
+    }
+
+    static void setParam(ParamTable &params, const char *label, float value) {
+        auto *zone{params.getZone(params.getIndex(label))};
+        if (zone) {
+            *zone = value;
+        }
+    }
+
+    static float generate(Signal signal, int source, int64_t n, int64_t length, int sampleRate,
+                          uint32_t &noiseState) {
+        switch (signal) {
+            case Signal::impulse: {
+                // Impulse sources take turns, so that each speaker's output
+                // has a single peak.
+                const int64_t segmentLength{segmentLengthFor(sampleRate)};
+                auto segment{n / segmentLength};
+                return source == segment % NUM_SOURCES && n % segmentLength == settleTimeFor(sampleRate) ?
+                       1.f : 0.f;
+            }
+            case Signal::sweep: {
+                // Sources start a quarter turn apart, so they don't sum to an
+                // impulse.
+                const double f0{20.}, f1{20000.}, duration{static_cast<double>(length) / sampleRate};
+                const double k{log(f1 / f0)};
+                auto t{static_cast<double>(n) / sampleRate};
+                auto phase{2. * M_PI * f0 * duration / k * (exp(t / duration * k) - 1.)};
+                return .5f * static_cast<float>(sin(phase + M_PI_2 * source));
+            }
+            default:
+                // Numerical Recipes' LCG.
+                noiseState = 1664525u * noiseState + 1013904223u;
+                return static_cast<float>(static_cast<int32_t>(noiseState)) * (.5f / 2147483648.f);
+        }
+    }
+
+    template<class Reference, class Candidate>
+    static void compare(Reference &reference, ParamTable &referenceParams,
+                        Candidate &candidate, ParamTable &candidateParams,
+                        int sampleRate, Signal signal, const Tolerance &tolerance, Result *results) {
+        const int64_t segmentLength{segmentLengthFor(sampleRate)};
+        const int64_t settleTime{settleTimeFor(sampleRate)};
+        const int64_t length{kNumSegments * segmentLength};
+
+        float inputBuffer[NUM_SOURCES][kBlockSize];
+        float referenceBuffer[SPEAKERS_PER_MODULE][kBlockSize], candidateBuffer[SPEAKERS_PER_MODULE][kBlockSize];
+        float *inputs[NUM_SOURCES], *referenceOutputs[SPEAKERS_PER_MODULE], *candidateOutputs[SPEAKERS_PER_MODULE];
+        for (int s{0}; s < NUM_SOURCES; ++s) {
+            inputs[s] = inputBuffer[s];
+        }
+        for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+            referenceOutputs[k] = referenceBuffer[k];
+            candidateOutputs[k] = candidateBuffer[k];
+        }
+
+        double signalEnergy[SPEAKERS_PER_MODULE]{}, errorEnergy[SPEAKERS_PER_MODULE]{};
+        float maxError[SPEAKERS_PER_MODULE]{};
+        int maxLag[SPEAKERS_PER_MODULE]{};
+        // Peak magnitudes and positions within the current segment.
+        float referencePeak[SPEAKERS_PER_MODULE]{}, candidatePeak[SPEAKERS_PER_MODULE]{};
+        int64_t referencePeakTime[SPEAKERS_PER_MODULE]{}, candidatePeakTime[SPEAKERS_PER_MODULE]{};
+        uint32_t noiseState[NUM_SOURCES];
+        for (int s{0}; s < NUM_SOURCES; ++s) {
+            noiseState[s] = 0x9e3779b9u * static_cast<uint32_t>(s + 1);
+        }
+
+        for (int64_t start{0}; start < length; start += kBlockSize) {
+            auto segmentStart{start % segmentLength == 0};
+            if (segmentStart) {
+                setScene(referenceParams, static_cast<int>(start / segmentLength));
+                setScene(candidateParams, static_cast<int>(start / segmentLength));
+            }
+
+            for (int s{0}; s < NUM_SOURCES; ++s) {
+                for (int n{0}; n < kBlockSize; ++n) {
+                    inputBuffer[s][n] = generate(signal, s, start + n, length, sampleRate, noiseState[s]);
+                }
+            }
+
+            reference.compute(kBlockSize, inputs, referenceOutputs);
+            candidate.compute(kBlockSize, inputs, candidateOutputs);
+
+            for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+                for (int n{0}; n < kBlockSize; ++n) {
+                    auto time{start + n};
+                    if (time % segmentLength < settleTime) {
+                        continue;
+                    }
+                    auto expected{referenceBuffer[k][n]}, actual{candidateBuffer[k][n]};
+                    auto error{actual - expected};
+                    signalEnergy[k] += static_cast<double>(expected) * expected;
+                    errorEnergy[k] += static_cast<double>(error) * error;
+                    maxError[k] = std::fmax(maxError[k], std::fabs(error));
+                    if (std::fabs(expected) > referencePeak[k]) {
+                        referencePeak[k] = std::fabs(expected);
+                        referencePeakTime[k] = time;
+                    }
+                    if (std::fabs(actual) > candidatePeak[k]) {
+                        candidatePeak[k] = std::fabs(actual);
+                        candidatePeakTime[k] = time;
+                    }
+                }
+
+                // At the end of each segment, compare the impulse's peaks.
+                if ((start + kBlockSize) % segmentLength == 0) {
+                    if (signal == Signal::impulse && referencePeak[k] > 0.f) {
+                        auto lag{static_cast<int>(candidatePeakTime[k] - referencePeakTime[k])};
+                        if (std::abs(lag) > std::abs(maxLag[k])) {
+                            maxLag[k] = lag;
+                        }
+                    }
+                    referencePeak[k] = candidatePeak[k] = 0.f;
+                }
+            }
+        }
+
+        for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+            auto &result{results[k]};
+            result.signal = signal;
+            result.speaker = k;
+            result.maxError = maxError[k];
+            result.snr = errorEnergy[k] > 0. ?
+                         static_cast<float>(10. * log10(signalEnergy[k] / errorEnergy[k])) :
+                         INFINITY;
+            result.lag = maxLag[k];
+            result.passed = result.maxError <= tolerance.maxError &&
+                            result.snr >= tolerance.minSNR &&
+                            std::abs(result.lag) <= tolerance.maxLag;
+        }
+    }
+};
+
+}
+
+#endif //TEENSY_WFS_RENDERCHECK_H
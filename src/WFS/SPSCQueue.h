@@ -0,0 +1,57 @@
+#ifndef TEENSY_WFS_SPSCQUEUE_H
+#define TEENSY_WFS_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Fixed-capacity, lock-free queue with a single producer and a single
+ * consumer, e.g. loop() and the audio interrupt. Neither side blocks: push()
+ * fails when the queue is full, and pop() when it is empty.
+ *
+ * @tparam kCapacity A power of two.
+ */
+template<class T, uint32_t kCapacity>
+class SPSCQueue {
+    static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+public:
+    /**
+     * Producer only.
+     */
+    bool push(const T &item) {
+        auto t{tail.load(std::memory_order_relaxed)};
+        if (t - head.load(std::memory_order_acquire) == kCapacity) {
+            return false;
+        }
+        items[t & kMask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only.
+     */
+    bool pop(T &item) {
+        auto h{head.load(std::memory_order_relaxed)};
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[h & kMask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint32_t kMask{kCapacity - 1};
+
+    T items[kCapacity];
+    // Free-running; only the producer writes tail, and the consumer head.
+    std::atomic<uint32_t> head{0}, tail{0};
+};
+
+#endif //TEENSY_WFS_SPSCQUEUE_H
@@ -0,0 +1,93 @@
+#include "SpeakerEQ.h"
+#include "FlushToZero.h"
+#include <EEPROM.h>
+
+// Identifies a stored coefficient set; includes the section count so that
+// changing EQ_MAX_SECTIONS invalidates whatever was stored previously.
+static constexpr uint32_t kStorageMagic{0x51450000 | SpeakerEQ::kMaxSections};
+
+bool SpeakerEQ::Section::isIdentity() const {
+    return b0 == 1.f && b1 == 0.f && b2 == 0.f && a1 == 0.f && a2 == 0.f;
+}
+
+void SpeakerEQ::setSection(int index, const Section &coefficients) {
+    if (index < 0 || index >= kMaxSections) {
+        return;
+    }
+    sections[index] = coefficients;
+    updateNumActiveSections();
+}
+
+const SpeakerEQ::Section &SpeakerEQ::getSection(int index) const {
+    return sections[index];
+}
+
+int SpeakerEQ::getNumActiveSections() const {
+    return numActiveSections;
+}
+
+void SpeakerEQ::reset() {
+    for (auto &section: sections) {
+        section = Section{};
+    }
+    numActiveSections = 0;
+    clear();
+}
+
+void SpeakerEQ::clear() {
+    for (int s{0}; s < kMaxSections; ++s) {
+        z1[s] = 0.f;
+        z2[s] = 0.f;
+    }
+}
+
+void SpeakerEQ::process(float *buffer, int numSamples) {
+    for (int s{0}; s < numActiveSections; ++s) {
+        const auto &c{sections[s]};
+        auto s1{z1[s]}, s2{z2[s]};
+        for (int n{0}; n < numSamples; ++n) {
+            auto x{buffer[n]};
+            auto y{c.b0 * x + s1};
+            s1 = c.b1 * x - c.a1 * y + s2;
+            s2 = c.b2 * x - c.a2 * y;
+            buffer[n] = y;
+        }
+        z1[s] = wfs::flushTiny(s1);
+        z2[s] = wfs::flushTiny(s2);
+    }
+}
+
+bool SpeakerEQ::load(int eepromAddress) {
+    uint32_t magic;
+    EEPROM.get(eepromAddress, magic);
+    if (magic != kStorageMagic) {
+        return false;
+    }
+    eepromAddress += sizeof(magic);
+    for (auto &section: sections) {
+        EEPROM.get(eepromAddress, section);
+        eepromAddress += sizeof(Section);
+    }
+    updateNumActiveSections();
+    clear();
+    return true;
+}
+
+void SpeakerEQ::store(int eepromAddress) const {
+    EEPROM.put(eepromAddress, kStorageMagic);
+    eepromAddress += sizeof(kStorageMagic);
+    for (const auto &section: sections) {
+        EEPROM.put(eepromAddress, section);
+        eepromAddress += sizeof(Section);
+    }
+}
+
+void SpeakerEQ::updateNumActiveSections() {
+    numActiveSections = 0;
+    for (int s{kMaxSections}; s > 0; --s) {
+        if (!sections[s - 1].isIdentity()) {
+            numActiveSections = s;
+            break;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef TEENSY_WFS_SPEAKEREQ_H
+#define TEENSY_WFS_SPEAKEREQ_H
+
+#include <cstdint>
+
+// Maximum number of biquad sections per speaker; set via build flags to trade
+// correction resolution against CPU (cost scales with active sections only).
+#ifndef EQ_MAX_SECTIONS
+#define EQ_MAX_SECTIONS 8
+#endif
+
+/**
+ * Speaker/room correction for a single output channel: a cascade of biquads
+ * (transposed direct form II) applied after the source mix, so its cost is
+ * independent of the number of sources.
+ *
+ * Sections default to identity; only sections up to the last non-identity
+ * one are processed.
+ */
+class SpeakerEQ {
+public:
+    /**
+     * Biquad coefficients, normalised such that a0 == 1.
+     */
+    struct Section {
+        float b0{1.f}, b1{0.f}, b2{0.f}, a1{0.f}, a2{0.f};
+
+        bool isIdentity() const;
+    };
+
+    static constexpr int kMaxSections{EQ_MAX_SECTIONS};
+
+    void setSection(int index, const Section &coefficients);
+
+    const Section &getSection(int index) const;
+
+    int getNumActiveSections() const;
+
+    /**
+     * Restore all sections to identity.
+     */
+    void reset();
+
+    /**
+     * Zero the filter state.
+     */
+    void clear();
+
+    void process(float *buffer, int numSamples);
+
+    /**
+     * Read coefficients from EEPROM, if a valid set was stored there.
+     * @return Whether coefficients were loaded.
+     */
+    bool load(int eepromAddress);
+
+    void store(int eepromAddress) const;
+
+    /**
+     * Number of EEPROM bytes occupied by one channel's stored coefficients.
+     */
+    static constexpr int kStorageSize{sizeof(uint32_t) + kMaxSections * sizeof(Section)};
+
+private:
+    void updateNumActiveSections();
+
+    Section sections[kMaxSections];
+    float z1[kMaxSections]{}, z2[kMaxSections]{};
+    int numActiveSections{0};
+};
+
+#endif //TEENSY_WFS_SPEAKEREQ_H
@@ -0,0 +1,53 @@
+#ifndef TEENSY_WFS_WFSPARAMS_H
+#define TEENSY_WFS_WFSPARAMS_H
+
+// Array parameters needed outside the Faust DSP. These mirror
+// src/faust/WFS_Params.lib; keep the two in step.
+
+// Number of speakers in the speaker array.
+#ifndef NUM_SPEAKERS
+#define NUM_SPEAKERS 16
+#endif
+
+// Each module (Teensy) controls two speakers.
+#ifndef SPEAKERS_PER_MODULE
+#define SPEAKERS_PER_MODULE 2
+#endif
+
+// Number of sound sources (i.e. mono channels); must match the inputs of the
+// generated Faust DSP.
+#ifndef NUM_SOURCES
+#define NUM_SOURCES 10
+#endif
+
+// Highest sample rate the renderer's delay lines are sized for. Build
+// configurations that raise AUDIO_SAMPLE_RATE_EXACT should raise this to
+// match; see platformio.ini.
+#ifndef MAX_SAMPLE_RATE
+#define MAX_SAMPLE_RATE 48000
+#endif
+
+// As the Teensy audio library's default.
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 128
+#endif
+
+// Speed of sound (c)
+constexpr float CELERITY{343.f};
+
+// max Y distance, in meters, that a source can be from the speaker array
+constexpr float MAX_Y_DIST{10.f};
+
+// distance (m) between individual speakers:
+constexpr float SPEAKER_DIST{.23f};
+
+// Distance (m) across which delays are rendered, i.e. the array width.
+constexpr float MAX_DELAY_DIST{(NUM_SPEAKERS - 1) * SPEAKER_DIST};
+
+// Number of speakers at each end of the array across which output is tapered
+// to reduce truncation artefacts. Zero disables tapering.
+#ifndef TAPER_SPEAKERS
+#define TAPER_SPEAKERS 2
+#endif
+
+#endif //TEENSY_WFS_WFSPARAMS_H
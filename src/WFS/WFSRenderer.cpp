@@ -0,0 +1,588 @@
+#include "WFSRenderer.h"
+#include "FlushToZero.h"
+#include <algorithm>
+#include <cmath>
+
+WFSRenderer::WFSRenderer() {
+    std::fill(params.gain, params.gain + kNumSources, 1.f);
+}
+
+void WFSRenderer::init(int sampleRate) {
+    fs = std::min(192000, std::max(1, sampleRate));
+    samplesPerMetre = static_cast<float>(fs) / CELERITY;
+    piOverFs = static_cast<float>(M_PI) / static_cast<float>(fs);
+    // As Faust's de.fdelay, allow reading one sample beyond the maximum delay.
+    // Above MAX_SAMPLE_RATE the delay lines are too short for the full array;
+    // clamp rather than read stale samples.
+    maxDelay = std::min(MAX_DELAY_DIST * samplesPerMetre + 1.f, static_cast<float>(kDelaySize - AUDIO_BLOCK_SAMPLES - kDecimation));
+    maxHighDelay = static_cast<int>(maxDelay) + kDecimation;
+    maxLowDelay = std::min(maxDelay / kDecimation + 1.f, static_cast<float>(kLowDelaySize - kLowBlockSize));
+    maxCutoff = .49f * static_cast<float>(fs);
+
+    // Split two octaves below the low band's Nyquist frequency.
+    for (auto &crossover: crossovers) {
+        designLowpass(static_cast<float>(fs) / (8.f * kDecimation), crossover.norm, crossover.a1, crossover.a2);
+    }
+
+    applied = params;
+    updateSpeakers();
+    for (int s{0}; s < kNumSources; ++s) {
+        updateReference(s);
+        updateFarMix(s);
+        for (int k{0}; k < kNumSpeakers; ++k) {
+            computePair(s, k);
+        }
+        computeSharedFilter(s);
+        active[s] = applied.mute[s] == 0.f && applied.gain[s] != 0.f && hasActivePairs(s);
+    }
+    clear();
+}
+
+void WFSRenderer::clear() {
+    for (int s{0}; s < kNumSources; ++s) {
+        clearSource(s);
+    }
+    writeIndex = 0;
+    lowWriteIndex = 0;
+    for (int k{0}; k < kNumSpeakers; ++k) {
+        lowPrevious[k] = 0.f;
+    }
+}
+
+void WFSRenderer::clearSource(int source) {
+    std::fill(delayLines[source], delayLines[source] + kDelaySize + AUDIO_BLOCK_SAMPLES, 0.f);
+    for (auto &pair: pairs[source]) {
+        pair.w1 = 0.f;
+        pair.w2 = 0.f;
+    }
+    sharedFilters[source].w1 = 0.f;
+    sharedFilters[source].w2 = 0.f;
+    std::fill(lowDelayLines[source], lowDelayLines[source] + kLowDelaySize + kLowBlockSize, 0.f);
+    crossovers[source].w1 = 0.f;
+    crossovers[source].w2 = 0.f;
+}
+
+void WFSRenderer::compute(int count, float **inputs, float **outputs) {
+    computeImp(count, inputs, outputs);
+}
+
+void WFSRenderer::compute(int count, const int16_t *const *inputs, float **outputs) {
+    computeImp(count, inputs, outputs);
+}
+
+template<typename Sample>
+void WFSRenderer::computeImp(int count, const Sample *const *inputs, float **outputs) {
+    updateCoefficients();
+
+    // Give the sample loops a compile-time trip count in the usual case, so
+    // that small blocks don't pay for loop overhead.
+    count = std::min(count, AUDIO_BLOCK_SAMPLES);
+    if (applied.subband != 0.f && count % kDecimation == 0) {
+        if (count == AUDIO_BLOCK_SAMPLES) {
+            renderSubbands<AUDIO_BLOCK_SAMPLES, Sample>(count, inputs, outputs);
+        } else {
+            renderSubbands<0, Sample>(count, inputs, outputs);
+        }
+        lowWriteIndex = (lowWriteIndex + count / kDecimation) & kLowDelayMask;
+    } else if (count == AUDIO_BLOCK_SAMPLES) {
+        render<AUDIO_BLOCK_SAMPLES, Sample>(count, inputs, outputs);
+    } else {
+        render<0, Sample>(count, inputs, outputs);
+    }
+
+    writeIndex = (writeIndex + count) & kDelayMask;
+}
+
+template<int kCount, typename Sample>
+void WFSRenderer::render(int count, const Sample *const *inputs, float **outputs) {
+    const int numSamples{kCount > 0 ? kCount : count};
+
+    for (int k{0}; k < kNumSpeakers; ++k) {
+        std::fill(outputs[k], outputs[k] + numSamples, 0.f);
+    }
+
+    for (int s{0}; s < kNumSources; ++s) {
+        if (!active[s]) {
+            continue;
+        }
+
+        auto *line{delayLines[s]};
+        const auto *in{inputs[s]};
+
+        if (applied.sharedFilter != 0.f) {
+            // Filter once, into the delay line...
+            auto &f{sharedFilters[s]};
+            auto w1{f.w1}, w2{f.w2};
+            for (int n{0}; n < numSamples; ++n) {
+                auto w0{toFloat(in[n]) - (f.a2 * w2 + f.a1 * w1)};
+                line[(writeIndex + n) & kDelayMask] = f.norm * (w2 + w0 + 2.f * w1);
+                w2 = w1;
+                w1 = w0;
+            }
+            f.w1 = wfs::flushTiny(w1);
+            f.w2 = wfs::flushTiny(w2);
+            mirrorDelayLine(line, kDelaySize, AUDIO_BLOCK_SAMPLES, writeIndex, numSamples);
+
+            // ...then just tap it for each speaker; gains are in the weights.
+            for (int k{0}; k < kNumSpeakers; ++k) {
+                const auto &p{pairs[s][k]};
+                if (!p.active) {
+                    continue;
+                }
+
+                auto *out{outputs[k]};
+                if (farMixes[s] > 0.f) {
+                    // Only the fractional delay is dropped; the line is
+                    // already filtered.
+                    renderFar(p, line, out, numSamples);
+                    if (farMixes[s] >= 1.f) {
+                        continue;
+                    }
+                }
+
+                const auto *x0{line + ((writeIndex - p.delay0) & kDelayMask)};
+                const auto *x1{line + ((writeIndex - p.delay1) & kDelayMask)};
+                for (int n{0}; n < numSamples; ++n) {
+                    out[n] += p.weight0 * x0[n] + p.weight1 * x1[n];
+                }
+            }
+            continue;
+        }
+
+        for (int n{0}; n < numSamples; ++n) {
+            line[(writeIndex + n) & kDelayMask] = toFloat(in[n]);
+        }
+        mirrorDelayLine(line, kDelaySize, AUDIO_BLOCK_SAMPLES, writeIndex, numSamples);
+
+        for (int k{0}; k < kNumSpeakers; ++k) {
+            auto &p{pairs[s][k]};
+            if (!p.active) {
+                continue;
+            }
+
+            auto *out{outputs[k]};
+            if (farMixes[s] > 0.f) {
+                // Level-of-detail tier: integer delay, no filter.
+                renderFar(p, line, out, numSamples);
+                if (farMixes[s] >= 1.f) {
+                    continue;
+                }
+            }
+
+            const auto *x0{line + ((writeIndex - p.delay0) & kDelayMask)};
+            const auto *x1{line + ((writeIndex - p.delay1) & kDelayMask)};
+            auto w1{p.w1}, w2{p.w2};
+            for (int n{0}; n < numSamples; ++n) {
+                auto x{p.weight0 * x0[n] + p.weight1 * x1[n]};
+                auto w0{p.gain * x - (p.a2 * w2 + p.a1 * w1)};
+                out[n] += p.norm * (w2 + w0 + 2.f * w1);
+                w2 = w1;
+                w1 = w0;
+            }
+            p.w1 = wfs::flushTiny(w1);
+            p.w2 = wfs::flushTiny(w2);
+        }
+    }
+}
+
+template<int kCount, typename Sample>
+void WFSRenderer::renderSubbands(int count, const Sample *const *inputs, float **outputs) {
+    const int numSamples{kCount > 0 ? kCount : count};
+    const int numLowSamples{numSamples / kDecimation};
+
+    for (int k{0}; k < kNumSpeakers; ++k) {
+        std::fill(outputs[k], outputs[k] + numSamples, 0.f);
+        std::fill(lowMix[k], lowMix[k] + numLowSamples, 0.f);
+    }
+
+    for (int s{0}; s < kNumSources; ++s) {
+        if (!active[s]) {
+            continue;
+        }
+
+        auto *line{delayLines[s]};
+        auto *lowLine{lowDelayLines[s]};
+        const auto *in{inputs[s]};
+
+        // Split the source. The low band is the crossover lowpass, decimated;
+        // the high band is the remainder, through the shared distance filter.
+        auto &c{crossovers[s]};
+        auto &f{sharedFilters[s]};
+        auto cw1{c.w1}, cw2{c.w2}, fw1{f.w1}, fw2{f.w2};
+        for (int m{0}; m < numLowSamples; ++m) {
+            for (int j{0}; j < kDecimation; ++j) {
+                auto n{m * kDecimation + j};
+                auto x{toFloat(in[n])};
+                auto cw0{x - (c.a2 * cw2 + c.a1 * cw1)};
+                auto low{c.norm * (cw2 + cw0 + 2.f * cw1)};
+                cw2 = cw1;
+                cw1 = cw0;
+                if (j == 0) {
+                    lowLine[(lowWriteIndex + m) & kLowDelayMask] = low;
+                }
+
+                auto fw0{x - low - (f.a2 * fw2 + f.a1 * fw1)};
+                line[(writeIndex + n) & kDelayMask] = f.norm * (fw2 + fw0 + 2.f * fw1);
+                fw2 = fw1;
+                fw1 = fw0;
+            }
+        }
+        c.w1 = wfs::flushTiny(cw1);
+        c.w2 = wfs::flushTiny(cw2);
+        f.w1 = wfs::flushTiny(fw1);
+        f.w2 = wfs::flushTiny(fw2);
+        mirrorDelayLine(line, kDelaySize, AUDIO_BLOCK_SAMPLES, writeIndex, numSamples);
+        mirrorDelayLine(lowLine, kLowDelaySize, kLowBlockSize, lowWriteIndex, numLowSamples);
+
+        for (int k{0}; k < kNumSpeakers; ++k) {
+            const auto &p{pairs[s][k]};
+            if (!p.active) {
+                continue;
+            }
+
+            // High band: a single integer tap.
+            auto *out{outputs[k]};
+            const auto *x{line + ((writeIndex - p.delay0) & kDelayMask)};
+            for (int n{0}; n < numSamples; ++n) {
+                out[n] += p.weight0 * x[n];
+            }
+
+            // Low band: fractional, at the low band rate.
+            auto *mix{lowMix[k]};
+            const auto *x0{lowLine + ((lowWriteIndex - p.lowDelay0) & kLowDelayMask)};
+            const auto *x1{lowLine + ((lowWriteIndex - p.lowDelay1) & kLowDelayMask)};
+            for (int m{0}; m < numLowSamples; ++m) {
+                mix[m] += p.lowWeight0 * x0[m] + p.lowWeight1 * x1[m];
+            }
+        }
+    }
+
+    // Bring each speaker's low band back up to the full rate by linear
+    // interpolation; this lags by kDecimation samples.
+    for (int k{0}; k < kNumSpeakers; ++k) {
+        auto *out{outputs[k]};
+        auto previous{lowPrevious[k]};
+        for (int m{0}; m < numLowSamples; ++m) {
+            auto step{(lowMix[k][m] - previous) / kDecimation};
+            for (int j{0}; j < kDecimation; ++j) {
+                out[m * kDecimation + j] += previous + step * static_cast<float>(j);
+            }
+            previous = lowMix[k][m];
+        }
+        lowPrevious[k] = previous;
+    }
+}
+
+void WFSRenderer::renderFar(const Pair &pair, const float *line, float *out, int numSamples) const {
+    const auto *x{line + ((writeIndex - pair.farDelay) & kDelayMask)};
+    for (int n{0}; n < numSamples; ++n) {
+        out[n] += pair.farWeight * x[n];
+    }
+}
+
+void WFSRenderer::mirrorDelayLine(float *line, int size, int guardSize, int index, int count) {
+    if (index < guardSize || index + count > size) {
+        std::copy(line, line + guardSize, line + size);
+    }
+}
+
+int WFSRenderer::getSampleRate() const {
+    return fs;
+}
+
+int WFSRenderer::getSplitGranularity() const {
+    return params.subband != 0.f ? kDecimation : 1;
+}
+
+void WFSRenderer::setGeometry(const ArrayGeometry &newGeometry) {
+    geometry = newGeometry;
+    geometryChanged = true;
+}
+
+float *WFSRenderer::getSourceXZone(int source) {
+    return &params.x[source];
+}
+
+float *WFSRenderer::getSourceYZone(int source) {
+    return &params.y[source];
+}
+
+float *WFSRenderer::getSourceGainZone(int source) {
+    return &params.gain[source];
+}
+
+float *WFSRenderer::getSourceMuteZone(int source) {
+    return &params.mute[source];
+}
+
+float *WFSRenderer::getModuleIDZone() {
+    return &params.moduleID;
+}
+
+float *WFSRenderer::getAntiAliasZone() {
+    return &params.antiAlias;
+}
+
+float *WFSRenderer::getSharedFilterZone() {
+    return &params.sharedFilter;
+}
+
+float *WFSRenderer::getSubbandZone() {
+    return &params.subband;
+}
+
+float *WFSRenderer::getLODDistanceZone() {
+    return &params.lodDistance;
+}
+
+float *WFSRenderer::getLODCrossfadeZone() {
+    return &params.lodCrossfade;
+}
+
+void WFSRenderer::updateCoefficients() {
+    // Read each zone once; they may be written mid-block.
+    auto moduleID{params.moduleID}, antiAlias{params.antiAlias};
+    auto lodDistance{params.lodDistance}, lodCrossfade{params.lodCrossfade};
+    auto all{geometryChanged || moduleID != applied.moduleID || antiAlias != applied.antiAlias ||
+             lodDistance != applied.lodDistance || lodCrossfade != applied.lodCrossfade};
+    if (geometryChanged || moduleID != applied.moduleID) {
+        applied.moduleID = moduleID;
+        updateSpeakers();
+        geometryChanged = false;
+    }
+    applied.antiAlias = antiAlias;
+    applied.lodDistance = lodDistance;
+    applied.lodCrossfade = lodCrossfade;
+
+    // With anti-aliasing, each speaker's cutoff depends on its angle to the
+    // source, which a lowpass shared by the module can't follow (octaves out,
+    // close to the array); render exactly instead.
+    auto approximate{antiAlias == 0.f};
+    auto sharedFilter{approximate ? params.sharedFilter : 0.f}, subband{approximate ? params.subband : 0.f};
+    if ((sharedFilter != 0.f) != (applied.sharedFilter != 0.f) ||
+        (subband != 0.f) != (applied.subband != 0.f)) {
+        // What the delay lines hold depends on the mode.
+        clear();
+        all = true;
+    }
+    applied.sharedFilter = sharedFilter;
+    applied.subband = subband;
+
+    for (int s{0}; s < kNumSources; ++s) {
+        auto x{params.x[s]}, y{params.y[s]}, gain{params.gain[s]}, mute{params.mute[s]};
+
+        applied.mute[s] = mute;
+
+        if (all || x != applied.x[s] || y != applied.y[s] || gain != applied.gain[s]) {
+            applied.x[s] = x;
+            applied.y[s] = y;
+            applied.gain[s] = gain;
+            updateReference(s);
+            updateFarMix(s);
+            for (int k{0}; k < kNumSpeakers; ++k) {
+                computePair(s, k);
+            }
+            computeSharedFilter(s);
+        }
+
+        auto isActive{mute == 0.f && gain != 0.f && hasActivePairs(s)};
+        if (isActive && !active[s]) {
+            // A skipped source's delay line hasn't been written to; don't
+            // replay whatever it held when it was last rendered.
+            clearSource(s);
+        }
+        active[s] = isActive;
+    }
+}
+
+void WFSRenderer::updateSpeakers() {
+    for (int j{0}; j < ArrayGeometry::kNumSpeakers; ++j) {
+        const auto &speaker{geometry.getSpeaker(j)};
+        tangentOffsets[j] = speaker.nx * speaker.x + speaker.ny * speaker.y;
+    }
+
+    auto firstSpeaker{static_cast<int>(applied.moduleID) * SPEAKERS_PER_MODULE};
+    for (int k{0}; k < kNumSpeakers; ++k) {
+        auto index{std::min(ArrayGeometry::kNumSpeakers - 1, std::max(0, firstSpeaker + k))};
+        const auto &speaker{geometry.getSpeaker(index)};
+        speakers[k] = {speaker.x, speaker.y, speaker.nx, speaker.ny, geometry.getSpacing(index)};
+    }
+
+    moduleCentre = {0.f, 0.f, 0.f, 0.f, 0.f};
+    for (const auto &speaker: speakers) {
+        moduleCentre.x += speaker.x / kNumSpeakers;
+        moduleCentre.y += speaker.y / kNumSpeakers;
+        moduleCentre.nx += speaker.nx;
+        moduleCentre.ny += speaker.ny;
+        moduleCentre.spacing += speaker.spacing / kNumSpeakers;
+    }
+    auto norm{sqrtf(moduleCentre.nx * moduleCentre.nx + moduleCentre.ny * moduleCentre.ny)};
+    if (norm > 0.f) {
+        moduleCentre.nx /= norm;
+        moduleCentre.ny /= norm;
+    } else {
+        moduleCentre.nx = speakers[0].nx;
+        moduleCentre.ny = speakers[0].ny;
+    }
+}
+
+void WFSRenderer::updateReference(int source) {
+    auto x{applied.x[source] * SPEAKER_DIST * NUM_SPEAKERS};
+    auto y{applied.y[source] * MAX_Y_DIST};
+
+    // The source's distance behind the nearest tangent of the array, taken
+    // over the speakers that face away from it. For a straight array this is
+    // just its distance from the array, y, as in WFS.dsp.
+    auto reference{-1.f};
+    for (int j{0}; j < ArrayGeometry::kNumSpeakers; ++j) {
+        const auto &speaker{geometry.getSpeaker(j)};
+        auto distance{tangentOffsets[j] - (speaker.nx * x + speaker.ny * y)};
+        if (distance >= 0.f && (reference < 0.f || distance < reference)) {
+            reference = distance;
+        }
+    }
+    references[source] = std::max(0.f, reference);
+}
+
+void WFSRenderer::updateFarMix(int source) {
+    auto farMix{0.f};
+    if (applied.lodDistance > 0.f && applied.subband == 0.f) {
+        auto beyond{references[source] - applied.lodDistance};
+        if (beyond > 0.f) {
+            farMix = applied.lodCrossfade > 0.f ? std::min(1.f, beyond / applied.lodCrossfade) : 1.f;
+        }
+    }
+
+    if (farMixes[source] >= 1.f && farMix < 1.f) {
+        // Filter states aren't updated in the level-of-detail tier.
+        for (auto &pair: pairs[source]) {
+            pair.w1 = 0.f;
+            pair.w2 = 0.f;
+        }
+    }
+    farMixes[source] = farMix;
+}
+
+bool WFSRenderer::hasActivePairs(int source) const {
+    for (const auto &pair: pairs[source]) {
+        if (pair.active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WFSRenderer::computePair(int source, int speaker) {
+    auto &p{pairs[source][speaker]};
+    const auto &s{speakers[speaker]};
+
+    // Use normalised input co-ordinate space; scale to dimensions.
+    auto x{applied.x[source] * SPEAKER_DIST * NUM_SPEAKERS};
+    auto y{applied.y[source] * MAX_Y_DIST};
+    // Distance between the source and this speaker; see WFS.dsp.
+    auto dx{x - s.x}, dy{y - s.y};
+    auto hypotenuse{sqrtf(dx * dx + dy * dy)};
+
+    // Secondary source selection: a speaker only radiates sources behind it,
+    // relative to its normal. Always true for the default, straight array.
+    auto wasActive{p.active};
+    p.active = s.nx * -dx + s.ny * -dy >= 0.f;
+    if (p.active && !wasActive) {
+        // Skipped pairs' filter states are stale.
+        p.w1 = 0.f;
+        p.w2 = 0.f;
+    }
+
+    auto delay{samplesPerMetre * (hypotenuse - references[source])};
+    auto delayFloor{floorf(delay)};
+    auto delayInt{static_cast<int>(delay)};
+    p.delay0 = static_cast<int>(std::min(maxDelay, static_cast<float>(std::max(0, delayInt))));
+    p.delay1 = static_cast<int>(std::min(maxDelay, static_cast<float>(std::max(0, delayInt + 1))));
+    p.weight0 = delayFloor + 1.f - delay;
+    p.weight1 = delay - delayFloor;
+
+    // Inverse square law, relative to a listening distance of 5 m.
+    auto distanceGain{5.f / (hypotenuse + 5.f)};
+    distanceGain *= distanceGain;
+    // Source gain costs nothing extra when folded in here.
+    auto gain{distanceGain * applied.gain[source]};
+
+    if (applied.subband != 0.f) {
+        // High band: nearest integer delay, plus the low band's lag.
+        p.delay0 = std::min(maxHighDelay, std::max(0, static_cast<int>(delay + .5f)) + kDecimation);
+        p.weight0 = gain;
+        // Low band: fractional delay at the low band rate.
+        auto lowDelay{std::max(0.f, delay) / kDecimation};
+        auto lowDelayInt{static_cast<int>(lowDelay)};
+        auto lowDelayFloor{static_cast<float>(lowDelayInt)};
+        p.lowDelay0 = static_cast<int>(std::min(maxLowDelay, lowDelayFloor));
+        p.lowDelay1 = static_cast<int>(std::min(maxLowDelay, lowDelayFloor + 1.f));
+        p.lowWeight0 = gain * (lowDelayFloor + 1.f - lowDelay);
+        p.lowWeight1 = gain * (lowDelay - lowDelayFloor);
+        return;
+    }
+
+    // Split the gain between the level-of-detail tier and full rendering.
+    auto farMix{farMixes[source]};
+    p.farDelay = std::min(static_cast<int>(maxDelay), std::max(0, static_cast<int>(delay + .5f)));
+    p.farWeight = gain * farMix;
+    gain *= 1.f - farMix;
+
+    if (applied.sharedFilter != 0.f) {
+        // The lowpass is shared by the module; see computeSharedFilter().
+        p.weight0 *= gain;
+        p.weight1 *= gain;
+        return;
+    }
+
+    if (farMix >= 1.f) {
+        // Not filtered at all.
+        return;
+    }
+
+    // Component of the source's offset along the array at this speaker.
+    auto tangential{fabsf(s.nx * dy - s.ny * dx)};
+    auto cutoff{std::min(computeCutoff(hypotenuse, tangential, s.spacing, applied.antiAlias != 0.f), maxCutoff)};
+    p.gain = gain;
+    designLowpass(cutoff, p.norm, p.a1, p.a2);
+}
+
+void WFSRenderer::computeSharedFilter(int source) {
+    auto &f{sharedFilters[source]};
+    const auto &c{moduleCentre};
+
+    auto dx{applied.x[source] * SPEAKER_DIST * NUM_SPEAKERS - c.x};
+    auto dy{applied.y[source] * MAX_Y_DIST - c.y};
+    auto hypotenuse{sqrtf(dx * dx + dy * dy)};
+    auto tangential{fabsf(c.nx * dy - c.ny * dx)};
+    auto cutoff{computeCutoff(hypotenuse, tangential, c.spacing, applied.antiAlias != 0.f)};
+
+    designLowpass(std::min(cutoff, maxCutoff), f.norm, f.a1, f.a2);
+}
+
+float WFSRenderer::computeCutoff(float hypotenuse, float tangential, float spacing, bool antiAlias) {
+    // Inverse square law gain, as computePair(), mapped to 5-20 kHz.
+    auto gain{5.f / (hypotenuse + 5.f)};
+    gain *= gain;
+    auto cutoff{gain * 15000.f + 5000.f};
+
+    if (antiAlias && tangential != 0.f) {
+        // Spatial aliasing frequency for the angle at which this speaker
+        // renders the source, c / (2 * dx * sin(theta)). Taking the lower of
+        // the two cutoffs merges the anti-aliasing and distance lowpasses into
+        // a single biquad.
+        auto aliasingFrequency{CELERITY * hypotenuse / (2.f * spacing * tangential)};
+        cutoff = std::min(cutoff, aliasingFrequency);
+    }
+
+    return cutoff;
+}
+
+void WFSRenderer::designLowpass(float cutoff, float &norm, float &a1, float &a2) const {
+    // Second-order Butterworth lowpass, as fi.lowpass(2, fc).
+    auto t{tanf(piOverFs * cutoff)};
+    auto invT{1.f / t};
+    norm = 1.f / ((invT + static_cast<float>(M_SQRT2)) * invT + 1.f);
+    a1 = norm * 2.f * (1.f - invT * invT);
+    a2 = norm * ((invT - static_cast<float>(M_SQRT2)) * invT + 1.f);
+}
@@ -0,0 +1,333 @@
+#ifndef TEENSY_WFS_WFSRENDERER_H
+#define TEENSY_WFS_WFSRENDERER_H
+
+#include <cstdint>
+#include "WFSParams.h"
+#include "ArrayGeometry.h"
+
+namespace wfs {
+constexpr int nextPowerOfTwo(int n, int p = 1) {
+    return p >= n ? p : nextPowerOfTwo(n, p << 1);
+}
+}
+
+/**
+ * Hand-written equivalent of the Faust WFS DSP (src/faust/WFS.dsp): each
+ * source is delayed and filtered (distance gain + lowpass) relative to each of
+ * this module's speakers, and merged onto the outputs.
+ *
+ * Only speakers that face away from a source radiate it (secondary source
+ * selection); other source/speaker pairs, and sources with no active pairs on
+ * this module, are skipped.
+ *
+ * Optionally, sources far from the array are rendered more cheaply, with
+ * integer delays and no per-speaker filter; see getLODDistanceZone().
+ *
+ * Unlike the generated code, filter and delay coefficients are only
+ * recomputed for sources whose position or gain (or the module ID, or the
+ * array geometry) has changed since the previous block.
+ *
+ * Parameters are exposed as zones, in the manner of a Faust DSP; writes are
+ * picked up at the start of the next call to compute().
+ */
+class WFSRenderer {
+public:
+    static constexpr int kNumSources{NUM_SOURCES};
+    static constexpr int kNumSpeakers{SPEAKERS_PER_MODULE};
+
+    WFSRenderer();
+
+    void init(int sampleRate);
+
+    /**
+     * Zero all delay lines and filter states.
+     */
+    void clear();
+
+    /**
+     * @param count Number of samples to process; at most AUDIO_BLOCK_SAMPLES.
+     */
+    void compute(int count, float **inputs, float **outputs);
+
+    /**
+     * As above, but reading 16-bit samples, as received from the audio
+     * library; they are converted as they are written to the delay lines,
+     * rather than in a separate pass.
+     */
+    void compute(int count, const int16_t *const *inputs, float **outputs);
+
+    int getSampleRate() const;
+
+    /**
+     * Granularity, in samples, at which a block may be split across several
+     * calls to compute(); subband mode needs multiples of its decimation
+     * factor. Reflects the mode as last written, i.e. as the next call to
+     * compute() will apply it.
+     */
+    int getSplitGranularity() const;
+
+    /**
+     * Use the given speaker positions and normals from the next call to
+     * compute(). Not safe to call concurrently with compute().
+     */
+    void setGeometry(const ArrayGeometry &newGeometry);
+
+    //region Parameter zones
+    /**
+     * Normalised (0-1) source x co-ordinate, along the width of the array.
+     */
+    float *getSourceXZone(int source);
+
+    /**
+     * Normalised (0-1) source y co-ordinate, from the array to MAX_Y_DIST.
+     */
+    float *getSourceYZone(int source);
+
+    /**
+     * Linear source gain; folded into the distance gain coefficient, so it
+     * costs nothing per sample.
+     */
+    float *getSourceGainZone(int source);
+
+    /**
+     * Non-zero to mute a source. Muted (or zero-gain) sources are skipped
+     * entirely by compute().
+     */
+    float *getSourceMuteZone(int source);
+
+    float *getModuleIDZone();
+
+    /**
+     * Non-zero to limit each source/speaker's bandwidth to the array's spatial
+     * aliasing frequency for that source position.
+     */
+    float *getAntiAliasZone();
+
+    /**
+     * Non-zero to approximate each source's distance filter with a single
+     * lowpass per module, designed for the source's distance from the centre
+     * of the module and applied before the delay line. Speaker gains remain
+     * exact. Ignored while anti-aliasing is on. Switching modes clears the
+     * delay lines.
+     */
+    float *getSharedFilterZone();
+
+    /**
+     * Non-zero to render in two bands, split at fs / 32: the low band at a
+     * quarter of the sampling rate, with fractional delays and no distance
+     * filter; the high band at the full rate, with integer delays and the
+     * shared distance filter. Ignored while anti-aliasing is on. Switching
+     * modes clears the delay lines.
+     */
+    float *getSubbandZone();
+
+    /**
+     * Distance from the array, in metres, beyond which sources are rendered
+     * with a single integer delay per speaker and no distance filter (the
+     * distance gain is kept). Zero (the default) to render every source in
+     * full. Not applied in subband mode. With the shared filter, the tier
+     * taps the filtered delay line, so keeps the shared lowpass.
+     */
+    float *getLODDistanceZone();
+
+    /**
+     * Width, in metres, of the band beyond the LOD distance across which
+     * sources are crossfaded from full to simplified rendering; both are
+     * rendered within it.
+     */
+    float *getLODCrossfadeZone();
+    //endregion
+
+    /**
+     * Distance filter cutoff, in Hz, for a source hypotenuse metres from a
+     * speaker (or, with the shared filter, the module centre) and, for
+     * anti-aliasing, offset tangential metres along the array there; before
+     * limiting to below Nyquist.
+     */
+    static float computeCutoff(float hypotenuse, float tangential, float spacing, bool antiAlias);
+
+private:
+    // Long enough for the maximum delay (plus one sample for interpolation) at
+    // MAX_SAMPLE_RATE, plus a block, as each block is written to the delay
+    // lines before being read. A power of two so indices can be masked.
+    static constexpr int kMaxDelay{static_cast<int>(MAX_DELAY_DIST * MAX_SAMPLE_RATE / CELERITY) + 2};
+    // Subband mode's low band sampling rate divisor; its low band lags the
+    // high band by this many samples, which the high band taps make up.
+    static constexpr int kDecimation{4};
+    static constexpr int kDelaySize{wfs::nextPowerOfTwo(kMaxDelay + kDecimation + AUDIO_BLOCK_SAMPLES)};
+    static constexpr int kDelayMask{kDelaySize - 1};
+    static constexpr int kLowBlockSize{AUDIO_BLOCK_SAMPLES / kDecimation};
+    static constexpr int kLowDelaySize{wfs::nextPowerOfTwo(kMaxDelay / kDecimation + 2 + kLowBlockSize)};
+    static constexpr int kLowDelayMask{kLowDelaySize - 1};
+
+    /**
+     * A source as rendered by one speaker: a fractional delay followed by a
+     * second-order lowpass, with the distance and source gains folded into
+     * its input. With the shared filter, the lowpass is unused and the gains
+     * are folded into the interpolation weights; in subband mode, the high
+     * band uses delay0 and weight0 alone.
+     */
+    struct Pair {
+        // Whether the speaker radiates the source at all; see computePair().
+        bool active{true};
+        // Linear interpolation between two integer delays.
+        int delay0{0}, delay1{0};
+        float weight0{1.f}, weight1{0.f};
+        // Lowpass coefficients.
+        float gain{0.f}, norm{0.f}, a1{0.f}, a2{0.f};
+        // Lowpass state.
+        float w1{0.f}, w2{0.f};
+        // Subband mode's low band delay, in low band samples, with gains
+        // folded into the weights.
+        int lowDelay0{0}, lowDelay1{0};
+        float lowWeight0{0.f}, lowWeight1{0.f};
+        // Level-of-detail tier: nearest integer delay, with gains and the
+        // source's far mix folded into the weight.
+        int farDelay{0};
+        float farWeight{0.f};
+    };
+
+    /**
+     * One of this module's speakers, as needed to compute its pairs.
+     */
+    struct Speaker {
+        float x{0.f}, y{0.f}, nx{0.f}, ny{-1.f};
+        float spacing{SPEAKER_DIST};
+    };
+
+    struct Params {
+        float x[kNumSources]{}, y[kNumSources]{};
+        float gain[kNumSources]{};
+        float mute[kNumSources]{};
+        float moduleID{0.f};
+        float antiAlias{0.f};
+        float sharedFilter{0.f};
+        float subband{0.f};
+        float lodDistance{0.f};
+        float lodCrossfade{1.f};
+    };
+
+    /**
+     * Second-order lowpass; with the shared filter, one per source.
+     */
+    struct Lowpass {
+        float norm{0.f}, a1{0.f}, a2{0.f};
+        float w1{0.f}, w2{0.f};
+    };
+
+    // Scaling of 16-bit input samples, as the Teensy wrapper's DIV_16.
+    static constexpr float kInt16Scale{1.f / 32767.f};
+
+    static float toFloat(float sample) { return sample; }
+
+    static float toFloat(int16_t sample) { return kInt16Scale * sample; }
+
+    template<typename Sample>
+    void computeImp(int count, const Sample *const *inputs, float **outputs);
+
+    /**
+     * @tparam kCount Number of samples to render, if known at compile time;
+     * zero to use count.
+     * @tparam Sample float, or int16_t.
+     */
+    template<int kCount, typename Sample>
+    void render(int count, const Sample *const *inputs, float **outputs);
+
+    /**
+     * @tparam kCount As render(); a multiple of kDecimation.
+     */
+    template<int kCount, typename Sample>
+    void renderSubbands(int count, const Sample *const *inputs, float **outputs);
+
+    /**
+     * Add a pair's level-of-detail tier, a single weighted tap, to out. line
+     * is whatever the mode writes to the delay lines: the input, or with the
+     * shared filter, the input lowpassed.
+     */
+    void renderFar(const Pair &pair, const float *line, float *out, int numSamples) const;
+
+    /**
+     * If a block written at index wrote to the start of a delay line, copy
+     * the start of the line to the guard region past its end, so that taps
+     * can read a block contiguously without masking each index.
+     */
+    static void mirrorDelayLine(float *line, int size, int guardSize, int index, int count);
+
+    void updateCoefficients();
+
+    /**
+     * Look up this module's speakers in the geometry table, and precompute
+     * the array-wide terms of each source's reference distance.
+     */
+    void updateSpeakers();
+
+    /**
+     * Compute the distance relative to which a source's delays are measured.
+     */
+    void updateReference(int source);
+
+    /**
+     * Work out how much of a source to render in the level-of-detail tier,
+     * from its reference distance.
+     */
+    void updateFarMix(int source);
+
+    void computePair(int source, int speaker);
+
+    /**
+     * Design a source's shared lowpass, for the centre of the module.
+     */
+    void computeSharedFilter(int source);
+
+    void designLowpass(float cutoff, float &norm, float &a1, float &a2) const;
+
+    bool hasActivePairs(int source) const;
+
+    /**
+     * Zero a source's delay line and filter states.
+     */
+    void clearSource(int source);
+
+    int fs{0};
+    float samplesPerMetre{0.f}, piOverFs{0.f}, maxDelay{0.f}, maxCutoff{0.f};
+    // As maxDelay, for the high and low bands in subband mode.
+    int maxHighDelay{0};
+    float maxLowDelay{0.f};
+
+    // Parameters as written by the outside world, and as last applied.
+    Params params, applied;
+
+    ArrayGeometry geometry;
+    bool geometryChanged{false};
+    Speaker speakers[kNumSpeakers];
+    // The mean of this module's speakers, for the shared filter.
+    Speaker moduleCentre;
+    // n.p for each speaker in the array, i.e. the offset of the line through
+    // the speaker perpendicular to its normal.
+    float tangentOffsets[ArrayGeometry::kNumSpeakers]{};
+    float references[kNumSources]{};
+    // 0 to render a source in full, 1 to render it in the level-of-detail
+    // tier alone; in between, both, crossfaded.
+    float farMixes[kNumSources]{};
+
+    // Whether each source is rendered, i.e. unmuted, with non-zero gain, and
+    // radiated by at least one of this module's speakers.
+    bool active[kNumSources]{};
+
+    Pair pairs[kNumSources][kNumSpeakers];
+    Lowpass sharedFilters[kNumSources];
+    // Subband mode's band-splitting lowpasses (coefficients shared).
+    Lowpass crossovers[kNumSources];
+    // Each delay line is followed by a copy of its first block; see
+    // mirrorDelayLine().
+    float delayLines[kNumSources][kDelaySize + AUDIO_BLOCK_SAMPLES]{};
+    int writeIndex{0};
+    // Subband mode's low band delay lines, and per-speaker mixes.
+    float lowDelayLines[kNumSources][kLowDelaySize + kLowBlockSize]{};
+    int lowWriteIndex{0};
+    float lowMix[kNumSpeakers][kLowBlockSize]{};
+    // Each speaker's last low band sample, for interpolation.
+    float lowPrevious[kNumSpeakers]{};
+};
+
+#endif //TEENSY_WFS_WFSRENDERER_H
@@ -1,9 +1,12 @@
 #include <NativeEthernet.h>
 #include <Audio.h>
-#include <OSCBundle.h>
 #include <JackTripClient.h>
-#include <vector>
-#include <memory>
+#include <algorithm>
+#include "PatchGraph.h"
+#include "ClockSync.h"
+#include "Log.h"
+#include "OscReader.h"
+#include "SceneFrame.h"
 #include "WFS/WFS.h"
 
 // Wait for a serial connection before proceeding with execution
@@ -28,6 +31,10 @@ IPAddress jackTripServerIP{192, 168, 10, 10};
 // Parameters for OSC over UDP multicast.
 IPAddress oscMulticastIP{230, 0, 0, 20};
 const uint16_t kOscMulticastPort{41814};
+// EEPROM location of persisted speaker EQ coefficients.
+const int kEQEepromAddress{0};
+// EEPROM location of the persisted array geometry, following the EQ.
+const int kGeometryEepromAddress{kEQEepromAddress + SPEAKERS_PER_MODULE * SpeakerEQ::kStorageSize};
 
 //region Audio system objects
 // Audio shield driver
@@ -40,12 +47,76 @@ EthernetUDP udp;
 
 WFS wfs;
 
-// Audio system connections
-// WFS outputs routed to Teensy outputs
-AudioConnection patchCord00(wfs, 0, out, 0);
-AudioConnection patchCord10(wfs, 1, out, 1);
+// Audio system connections, made in setup().
+PatchGraph patchGraph;
 
-std::vector<std::unique_ptr<AudioConnection>> patchCords;
+// Audio memory pool, sized from the patch graph.
+audio_block_t *audioMemory{nullptr};
+int audioMemorySize{0};
+//endregion
+
+//region Position scheduling
+// Positions are applied this long after the controller sent them, by which
+// time they should have reached every module.
+const float kScheduleLatency{.02f};
+// Seconds over which to estimate the offset from the controller's clock.
+const float kClockSyncWindow{2.f};
+ClockSync clockSync{AUDIO_SAMPLE_RATE_EXACT, kScheduleLatency, kClockSyncWindow};
+// When to apply the positions in the bundle being parsed, in samples (see
+// WFS::getSampleTime()); 0 for now.
+uint64_t bundleTime{0};
+//endregion
+
+//region OSC receive
+// Largest packet accepted; an Ethernet frame's worth of UDP payload.
+const int kOscBufferSize{1472};
+// Longest receiveOSC() may spend reading packets per call, in microseconds.
+const uint32_t kOscTimeBudget{500};
+// After this many passes of loop() in a row that run out of time, staged
+// positions are committed anyway, so that a flood of packets can't hold them
+// back.
+const int kMaxUndrainedReads{4};
+int undrainedReads{0};
+uint8_t oscBuffer[kOscBufferSize];
+// Reads each packet in oscBuffer in place.
+OscReader oscIn;
+
+struct OscStats {
+    uint32_t packets;
+    uint64_t parseCycles;
+    uint32_t parseCyclesMax;
+    // Packets skipped for being bigger than oscBuffer, and packets at least
+    // partly malformed.
+    uint32_t oversized;
+    uint32_t malformed;
+    // Calls to receiveOSC() that ran out of time with packets pending.
+    uint32_t budgetExceeded;
+    // Scene frames applied, and those discarded as malformed, duplicate or
+    // older than one already applied.
+    uint32_t frames;
+    uint32_t framesDiscarded;
+    // Gaps in frames' sequence numbers.
+    uint32_t framesLost;
+};
+// Since the last performance report.
+OscStats oscStats{};
+//endregion
+
+//region Scene frames
+SceneFrame sceneIn;
+// Session and sequence number of the last frame applied.
+uint32_t sceneSession{0};
+uint32_t sceneSequence{0};
+bool sceneSequenceValid{false};
+//endregion
+
+//region Persistence
+// EQ and geometry changes are written to EEPROM, which is emulated in flash
+// and slow to write, once they've stopped arriving for this long (ms), rather
+// than per message.
+const uint32_t kStoreDelay{2000};
+bool eqChanged{false}, geometryChanged{false};
+elapsedMillis sinceEQChange, sinceGeometryChange;
 //endregion
 
 //region Performance report params
@@ -56,11 +127,51 @@ const uint32_t PERF_REPORT_INTERVAL = 5000;
 //region Forward declarations
 void startAudio();
 
-void receiveOSC();
+bool receiveOSC();
+
+void storeChanges();
+
+void handlePacket(int size);
+
+void handleSceneFrame(int size, uint64_t arrival);
+
+void parsePosition(const OscReader::Message &msg, const char *path);
+
+void parseModule(const OscReader::Message &msg, const char *path);
 
-void parsePosition(OSCMessage &msg, int addrOffset);
+void parseEQ(const OscReader::Message &msg, const char *path);
 
-void parseModule(OSCMessage &msg, int addrOffset);
+void parseAntiAlias(const OscReader::Message &msg, const char *path);
+
+void parseGeometry(const OscReader::Message &msg, const char *path);
+
+void parseSharedFilter(const OscReader::Message &msg, const char *path);
+
+void parseSubband(const OscReader::Message &msg, const char *path);
+
+void parseLOD(const OscReader::Message &msg, const char *path);
+
+void routeMessage(const OscReader::Message &msg);
+//endregion
+
+//region OSC routes
+// Handlers by address prefix; each is passed the rest of the address, e.g.
+// "0/x" for "/source/0/x".
+struct OscRoute {
+    const char *prefix;
+    void (*handler)(const OscReader::Message &msg, const char *path);
+};
+
+const OscRoute kOscRoutes[]{
+        {"/source",       parsePosition},
+        {"/module",       parseModule},
+        {"/eq",           parseEQ},
+        {"/antialias",    parseAntiAlias},
+        {"/geometry",     parseGeometry},
+        {"/sharedfilter", parseSharedFilter},
+        {"/subband",      parseSubband},
+        {"/lod",          parseLOD}
+};
 //endregion
 
 void setup() {
@@ -73,15 +184,28 @@ void setup() {
         CrashReport.clear();
     }
 
-    // Autopatch jtc to wfs, and to itself for sending back to the server.
+    // WFS outputs routed to Teensy outputs.
+    for (int i = 0; i < SPEAKERS_PER_MODULE; ++i) {
+        patchGraph.connect(wfs, i, out, i);
+    }
+    // The I2S output double-buffers each of its channels.
+    patchGraph.addHeldBlocks(2 * SPEAKERS_PER_MODULE);
+    // Autopatch jtc to wfs, as far as wfs has inputs, and to itself for
+    // sending back to the server.
+    for (int i = 0; i < std::min(NUM_JACKTRIP_CHANNELS, NUM_SOURCES); ++i) {
+        patchGraph.connect(jtc, i, wfs, i);
+    }
     for (int i = 0; i < NUM_JACKTRIP_CHANNELS; ++i) {
-        patchCords.push_back(std::make_unique<AudioConnection>(jtc, i, wfs, i));
-        patchCords.push_back(std::make_unique<AudioConnection>(jtc, i, jtc, i));
+        patchGraph.connect(jtc, i, jtc, i);
     }
 
     Serial.printf("Sampling rate: %f\n", AUDIO_SAMPLE_RATE_EXACT);
     Serial.printf("Audio block samples: %d\n", AUDIO_BLOCK_SAMPLES);
 
+#if defined(WFS_SELF_CHECK) && !defined(WFS_REFERENCE_DSP)
+    WFS::runSelfCheck();
+#endif
+
 #ifdef SHOW_STATS
     jtc.setShowStats(true, 5'000);
 #endif
@@ -96,7 +220,23 @@ void setup() {
         WAIT_INFINITE()
     }
 
-    AudioMemory(32);
+    // As AudioMemory(), but sized at runtime.
+    audioMemorySize = patchGraph.getRequiredBlocks();
+    audioMemory = new audio_block_t[audioMemorySize];
+    AudioStream::initialize_memory(audioMemory, audioMemorySize);
+    Serial.printf("Audio memory: %d blocks\n", audioMemorySize);
+
+    if (wfs.loadEQ(kEQEepromAddress)) {
+        Serial.printf("Loaded speaker EQ: %d, %d sections\n",
+                      wfs.getNumEQSections(0),
+                      wfs.getNumEQSections(1));
+    }
+
+    if (wfs.loadGeometry(kGeometryEepromAddress)) {
+        Serial.println("Loaded array geometry.");
+    }
+
+    wfs.printMemoryReport();
 
     startAudio();
 }
@@ -112,48 +252,195 @@ void loop() {
 //        receiveOSC();
 
         if (performanceReport > PERF_REPORT_INTERVAL) {
-            Serial.printf("Audio memory in use: %d blocks; processor %f %%\n",
-                          AudioMemoryUsage(),
-                          AudioProcessorUsage());
+            LOG_INFO("Audio memory in use: %d blocks (max %d of %d); processor %f %%\n",
+                     AudioMemoryUsage(),
+                     AudioMemoryUsageMax(),
+                     audioMemorySize,
+                     AudioProcessorUsage());
+            // Any object can fail to allocate once the pool runs dry; only
+            // the WFS object's failures can be counted directly.
+            if (AudioMemoryUsageMax() >= audioMemorySize) {
+                LOG_WARN("Audio memory exhausted; jtc and the I2S output may have dropped blocks "
+                         "(not counted).\n");
+            }
+            auto cyclesPerMicro{F_CPU_ACTUAL / 1'000'000};
+            LOG_INFO("OSC: %.1f packets/s; parse mean %lu us, max %lu us; %lu oversized; "
+                     "%lu malformed; %lu reads over budget\n",
+                     1000.f * static_cast<float>(oscStats.packets) / static_cast<float>(performanceReport),
+                     static_cast<uint32_t>(oscStats.packets > 0 ? oscStats.parseCycles / oscStats.packets / cyclesPerMicro : 0),
+                     oscStats.parseCyclesMax / cyclesPerMicro,
+                     oscStats.oversized,
+                     oscStats.malformed,
+                     oscStats.budgetExceeded);
+            LOG_INFO("Scene frames: %lu applied, %lu discarded, %lu lost\n",
+                     oscStats.frames, oscStats.framesDiscarded, oscStats.framesLost);
+            oscStats = {};
+            auto positions{wfs.getPositionQueueStats()};
+            LOG_INFO("Source positions: %lu committed, %lu applied, %lu held back (queue full), %lu late, "
+                     "%lu early (schedule full)\n",
+                     positions.committed, positions.applied, positions.overflows, positions.late,
+                     positions.early);
+            if (clockSync.isSynchronised()) {
+                LOG_INFO("Controller clock offset: %lld samples\n", clockSync.getOffset());
+            }
+            char dropped[Log::kMaxLength]{};
+            int length{0};
+            for (int i = 0; i < SPEAKERS_PER_MODULE && length < Log::kMaxLength; ++i) {
+                length += snprintf(dropped + length, sizeof(dropped) - length, " %lu", wfs.getAllocationFailures(i));
+            }
+            LOG_INFO("WFS output blocks dropped:%s (only WFS is counted)\n", dropped);
+            LOG_INFO("Speaker EQ: %d, %d sections\n",
+                     wfs.getNumEQSections(0),
+                     wfs.getNumEQSections(1));
+            // A block's worth of time at the CPU clock is the budget.
+            auto &profile{wfs.getProfileMax()};
+            auto blockCycles{static_cast<float>(F_CPU_ACTUAL) * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT};
+            auto totalCycles{profile.input + profile.render + profile.eq + profile.output};
+            LOG_INFO("WFS max cycles/block: input %lu, render %lu, EQ %lu, output %lu; "
+                     "%.1f %% of block period (%d samples)\n",
+                     profile.input, profile.render, profile.eq, profile.output,
+                     100.f * static_cast<float>(totalCycles) / blockCycles,
+                     AUDIO_BLOCK_SAMPLES);
+            wfs.resetProfileMax();
+#ifdef WFS_COUNT_DENORMALS
+            LOG_INFO("Blocks with subnormals: %lu\n", wfs.getDenormalBlockCount());
+#endif
+            if (Log::getDropped() > 0) {
+                LOG_WARN("Log messages dropped: %lu\n", Log::getDropped());
+            }
             performanceReport = 0;
         }
     }
 
-    receiveOSC();
+    // Positions from separate messages or bundles sent together (x then y)
+    // are committed together once there's nothing left to read, or, while
+    // packets keep coming, every kMaxUndrainedReads passes regardless.
+    if (receiveOSC() || ++undrainedReads >= kMaxUndrainedReads) {
+        wfs.commitSourcePositions();
+        undrainedReads = 0;
+    }
+
+    storeChanges();
+
+    // Last, so that serial output never holds up the above.
+    Log::drain();
 }
 
-void parsePosition(OSCMessage &msg, int addrOffset) {
-    // Get the source index and coordinate axis, e.g. "0/x"
-    char path[20];
-    msg.getAddress(path, addrOffset + 1);
-    // Rough-and-ready check to prevent attempting to set an invalid source
-    // position.
+void parsePosition(const OscReader::Message &msg, const char *path) {
+    // path is the source index and parameter, e.g. "0/x", "0/gain".
+    // The WFS object has NUM_SOURCES sources, however many channels JackTrip
+    // carries.
     auto sourceIdx{atoi(path)};
-    if (sourceIdx >= jtc.getNumChannels()) {
-        Serial.printf("Invalid source index: %d\n", sourceIdx);
+    if (sourceIdx < 0 || sourceIdx >= NUM_SOURCES) {
+        LOG_WARN("Invalid source index: %d\n", sourceIdx);
         return;
     }
-    // Get the coordinate value (0-1).
+    // Get the value; co-ordinates are 0-1.
     auto pos = msg.getFloat(0);
-    Serial.printf("Setting \"%s\": %f\n", path, pos);
-    // Set the parameter.
-    wfs.setParamValue(path, pos);
+    LOG_DEBUG("Setting \"%s\": %f\n", path, pos);
+    // Set the parameter; positions directly, anything else by label.
+    auto param{strchr(path, '/')};
+    if (param && strcmp(param, "/x") == 0) {
+        wfs.setSourceX(sourceIdx, pos, bundleTime);
+    } else if (param && strcmp(param, "/y") == 0) {
+        wfs.setSourceY(sourceIdx, pos, bundleTime);
+    } else {
+        wfs.setParamValue(path, pos);
+    }
+}
+
+void parseModule(const OscReader::Message &msg, const char *path) {
+    auto ipString{msg.getString(0)};
+    IPAddress ip;
+    if (ipString && ip.fromString(ipString) && ip == EthernetClass::localIP()) {
+        auto numericID = strtof(path, nullptr);
+        LOG_INFO("Setting module ID: %f\n", numericID);
+        wfs.setModuleID(static_cast<int>(numericID));
+    }
 }
 
-void parseModule(OSCMessage &msg, int addrOffset) {
-    char ipString[15];
+void parseEQ(const OscReader::Message &msg, const char *path) {
+    auto ipString{msg.getString(0)};
     IPAddress ip;
-    msg.getString(0, ipString, 15);
-    ip.fromString(ipString);
-    if (ip == EthernetClass::localIP()) {
-        char id[2];
-        msg.getAddress(id, addrOffset + 1);
-        auto numericID = strtof(id, nullptr);
-        Serial.printf("Setting module ID: %f\n", numericID);
-        wfs.setParamValue("moduleID", numericID);
+    if (ipString && ip.fromString(ipString) && ip == EthernetClass::localIP()) {
+        // path is the output channel and section index, e.g. "1/3"
+        char *sectionStr;
+        auto channel{strtol(path, &sectionStr, 10)};
+        if (*sectionStr != '/') {
+            LOG_WARN("Invalid EQ address: %s\n", path);
+            return;
+        }
+        auto section{strtol(sectionStr + 1, nullptr, 10)};
+        if (section < 0 || section >= SpeakerEQ::kMaxSections) {
+            LOG_WARN("Invalid EQ section: %ld\n", section);
+            return;
+        }
+        SpeakerEQ::Section coeffs{msg.getFloat(1),
+                                  msg.getFloat(2),
+                                  msg.getFloat(3),
+                                  msg.getFloat(4),
+                                  msg.getFloat(5)};
+        LOG_INFO("Setting EQ %ld/%ld: %f %f %f %f %f\n", channel, section,
+                 coeffs.b0, coeffs.b1, coeffs.b2, coeffs.a1, coeffs.a2);
+        wfs.setEQSection(channel, section, coeffs);
+        eqChanged = true;
+        sinceEQChange = 0;
+    }
+}
+
+void parseAntiAlias(const OscReader::Message &msg, const char *path) {
+    auto enable{msg.getFloat(0)};
+    LOG_INFO("Setting anti-aliasing: %s\n", enable != 0.f ? "on" : "off");
+    wfs.setParamValue("antiAlias", enable);
+}
+
+void parseSharedFilter(const OscReader::Message &msg, const char *path) {
+    auto enable{msg.getFloat(0)};
+    LOG_INFO("Setting shared distance filter: %s\n", enable != 0.f ? "on" : "off");
+    wfs.setParamValue("sharedFilter", enable);
+}
+
+void parseSubband(const OscReader::Message &msg, const char *path) {
+    auto enable{msg.getFloat(0)};
+    LOG_INFO("Setting subband rendering: %s\n", enable != 0.f ? "on" : "off");
+    wfs.setParamValue("subband", enable);
+}
+
+void parseLOD(const OscReader::Message &msg, const char *path) {
+    auto distance{msg.getFloat(0)};
+    LOG_INFO("Setting level-of-detail distance: %f m\n", distance);
+    wfs.setParamValue("lodDistance", distance);
+    if (msg.size() > 1) {
+        auto crossfade{msg.getFloat(1)};
+        LOG_INFO("Setting level-of-detail crossfade: %f m\n", crossfade);
+        wfs.setParamValue("lodCrossfade", crossfade);
     }
 }
 
+void parseGeometry(const OscReader::Message &msg, const char *path) {
+    // path is the speaker index, or "reset".
+    if (strcmp(path, "reset") == 0) {
+        LOG_INFO("Resetting array geometry\n");
+        wfs.resetGeometry();
+    } else {
+        char *end;
+        auto speaker{strtol(path, &end, 10)};
+        if (end == path || speaker < 0 || speaker >= ArrayGeometry::kNumSpeakers) {
+            LOG_WARN("Invalid speaker index: %s\n", path);
+            return;
+        }
+        ArrayGeometry::Speaker geometry{msg.getFloat(0),
+                                        msg.getFloat(1),
+                                        msg.getFloat(2),
+                                        msg.getFloat(3)};
+        LOG_INFO("Setting speaker %ld geometry: (%f, %f), normal (%f, %f)\n", speaker,
+                 geometry.x, geometry.y, geometry.nx, geometry.ny);
+        wfs.setSpeakerGeometry(speaker, geometry);
+    }
+    geometryChanged = true;
+    sinceGeometryChange = 0;
+}
+
 /**
  * Expects messages of the form:
  *
@@ -163,36 +450,152 @@ void parseModule(OSCMessage &msg, int addrOffset) {
  * set source 0 co-ordinates
  * /source/0/x [0.0-1.0]
  * /source/0/y [0.0-1.0]
+ *
+ * set source 0 gain (linear), and mute/unmute it
+ * /source/0/gain [0.0-2.0]
+ * /source/0/mute [0|1]
+ *
+ * set biquad section 3 of output channel 1's correction EQ (a0 == 1)
+ * /eq/1/3 "[IP address]" b0 b1 b2 a1 a2
+ *
+ * enable/disable spatial anti-aliasing filtering
+ * /antialias [0|1]
+ *
+ * enable/disable the per-module shared distance filter approximation;
+ * ignored while anti-aliasing is on
+ * /sharedfilter [0|1]
+ *
+ * enable/disable two-band rendering (decimated low band); experimental,
+ * and no cheaper than /sharedfilter on the host; ignored while
+ * anti-aliasing is on
+ * /subband [0|1]
+ *
+ * render sources beyond 6 m from the array with integer delays and no
+ * filter (with /sharedfilter, the shared filter is kept), crossfading over
+ * the 2 m beyond that (0 m to disable)
+ * /lod 6.0 [2.0]
+ *
+ * set speaker 5's position (metres) and normal (into the listening area),
+ * or restore the default straight-line array
+ * /geometry/5 x y nx ny
+ * /geometry/reset
+ *
+ * Source positions may instead arrive as scene frames; see SceneFrame.h.
+ *
+ * Reads every pending packet, for up to kOscTimeBudget.
+ *
+ * @return Whether the socket was drained within the time budget.
  */
-void receiveOSC() {
-    OSCBundle bundleIn;
-    OSCMessage messageIn;
-    int size;
-    if ((size = udp.parsePacket())) {
-//        Serial.printf("Packet size: %d\n", size);
-        uint8_t buffer[size];
-        udp.read(buffer, size);
-
-        // Try to read as bundle
-        bundleIn.fill(buffer, size);
-        if (!bundleIn.hasError() && bundleIn.size() > 0) {
-//            Serial.printf("OSCBundle::size: %d\n", bundleIn.size());
-
-            bundleIn.route("/source", parsePosition);
-            bundleIn.route("/module", parseModule);
-        } else {
-            // Try as message
-            messageIn.fill(buffer, size);
-            if (!messageIn.hasError() && messageIn.size() > 0) {
-//                Serial.printf("OSCMessage::size: %d\n", messageIn.size());
-
-                messageIn.route("/source", parsePosition);
-                messageIn.route("/module", parseModule);
-            }
+bool receiveOSC() {
+    elapsedMicros elapsed;
+    while (elapsed < kOscTimeBudget) {
+        auto size{udp.parsePacket()};
+        if (size <= 0) {
+            return true;
+        }
+        auto start{ARM_DWT_CYCCNT};
+        handlePacket(size);
+        auto cycles{ARM_DWT_CYCCNT - start};
+        oscStats.packets++;
+        oscStats.parseCycles += cycles;
+        oscStats.parseCyclesMax = std::max(oscStats.parseCyclesMax, cycles);
+    }
+    oscStats.budgetExceeded++;
+    return false;
+}
+
+void handlePacket(int size) {
+    // Anything bigger than the buffer is skipped; the next parsePacket()
+    // discards it.
+    if (size > kOscBufferSize) {
+        oscStats.oversized++;
+        return;
+    }
+    auto arrival{wfs.getSampleTime()};
+    udp.read(oscBuffer, size);
+
+    if (SceneFrame::isFrame(oscBuffer, size)) {
+        handleSceneFrame(size, arrival);
+        return;
+    }
+
+    if (!oscIn.read(oscBuffer, size)) {
+        oscStats.malformed++;
+        return;
+    }
+    if (oscIn.isBundle()) {
+        clockSync.observe(oscIn.getTimetag(), arrival);
+        bundleTime = clockSync.schedule(oscIn.getTimetag());
+    }
+    // A bundle's messages are applied in order, skipping any malformed.
+    OscReader::Message message;
+    while (oscIn.next(message)) {
+        routeMessage(message);
+    }
+    bundleTime = 0;
+    if (oscIn.hasError()) {
+        oscStats.malformed++;
+    }
+}
+
+void routeMessage(const OscReader::Message &msg) {
+    for (const auto &route: kOscRoutes) {
+        auto path{msg.match(route.prefix)};
+        if (path) {
+            route.handler(msg, path);
+            return;
         }
     }
 }
 
+void handleSceneFrame(int size, uint64_t arrival) {
+    if (!sceneIn.decode(oscBuffer, size)) {
+        oscStats.framesDiscarded++;
+        return;
+    }
+    // A new session means the controller has restarted, and numbers its
+    // frames afresh. Within a session, frames carry every position, so one
+    // that's been overtaken by a later frame has nothing to add.
+    auto newSession{!sceneSequenceValid || sceneIn.session != sceneSession};
+    auto ahead{static_cast<int32_t>(sceneIn.sequence - sceneSequence)};
+    if (!newSession && ahead <= 0) {
+        oscStats.framesDiscarded++;
+        return;
+    }
+    if (!newSession && ahead > 1) {
+        oscStats.framesLost += ahead - 1;
+    }
+    sceneSession = sceneIn.session;
+    sceneSequence = sceneIn.sequence;
+    sceneSequenceValid = true;
+    oscStats.frames++;
+
+    clockSync.observe(sceneIn.timetag, arrival);
+    auto when{clockSync.schedule(sceneIn.timetag)};
+    // Only the sources that moved, unless frames with other moves in them may
+    // have been missed.
+    auto apply{sceneIn.valid & (newSession || ahead > 1 ? ~uint64_t{0} : sceneIn.changed)};
+    auto numSources{std::min(sceneIn.numSources, NUM_SOURCES)};
+    for (int i = 0; i < numSources; ++i) {
+        if (apply & SceneFrame::bit(i)) {
+            wfs.setSourcePosition(i, sceneIn.x[i], sceneIn.y[i], when);
+        }
+    }
+}
+
+void storeChanges() {
+    if (eqChanged && sinceEQChange > kStoreDelay) {
+        wfs.storeEQ(kEQEepromAddress);
+        eqChanged = false;
+        LOG_INFO("Stored speaker EQ\n");
+    }
+    if (geometryChanged && sinceGeometryChange > kStoreDelay) {
+        wfs.storeGeometry(kGeometryEepromAddress);
+        geometryChanged = false;
+        LOG_INFO("Stored array geometry\n");
+    }
+}
+
 void startAudio() {
     audioShield.enable();
     // "...0.8 corresponds to the maximum undistorted output for a full scale
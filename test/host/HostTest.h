@@ -0,0 +1,24 @@
+#ifndef TEENSY_WFS_HOSTTEST_H
+#define TEENSY_WFS_HOSTTEST_H
+
+#include <cstdio>
+
+// Minimal assertions for the host tests: failures are reported and counted,
+// and main() returns hostTestFailures() so that make stops.
+
+inline int &hostTestFailures() {
+    static int failures{0};
+    return failures;
+}
+
+#define EXPECT(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL %s:%d: %s: ", __FILE__, __LINE__, #condition); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            ++hostTestFailures(); \
+        } \
+    } while (false)
+
+#endif //TEENSY_WFS_HOSTTEST_H
@@ -0,0 +1,41 @@
+#ifndef TEENSY_WFS_TEST_ARDUINO_H
+#define TEENSY_WFS_TEST_ARDUINO_H
+
+// Host stand-in for as much of the Teensy 4 core as the sources under test
+// use. As on the Teensy, F_CPU_ACTUAL is a variable, not a constant.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+class HostSerial {
+public:
+    template<class... Args>
+    int printf(const char *format, Args... args) { return ::printf(format, args...); }
+
+    void print(const char *text) { fputs(text, stdout); }
+
+    void println(const char *text = "") { puts(text); }
+
+    int availableForWrite() { return 64; }
+
+    size_t write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+
+    explicit operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+extern volatile uint32_t F_CPU_ACTUAL;
+
+// The cycle counter; tests advance it to emulate the passage of time.
+extern volatile uint32_t hostCycleCount;
+#define ARM_DWT_CYCCNT hostCycleCount
+
+#define DMAMEM
+#define EXTMEM
+#define FASTRUN
+
+#endif //TEENSY_WFS_TEST_ARDUINO_H
@@ -0,0 +1,6 @@
+#ifndef TEENSY_WFS_TEST_AUDIO_H
+#define TEENSY_WFS_TEST_AUDIO_H
+
+#include "AudioStream.h"
+
+#endif //TEENSY_WFS_TEST_AUDIO_H
@@ -0,0 +1,57 @@
+#ifndef TEENSY_WFS_TEST_AUDIOSTREAM_H
+#define TEENSY_WFS_TEST_AUDIOSTREAM_H
+
+// Host stand-in for the Teensy audio library's AudioStream. Tests supply each
+// input's block in hostInputs (null for silence), and read what each output
+// transmitted from hostOutputs.
+
+#include "Arduino.h"
+
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 128
+#endif
+
+#ifndef AUDIO_SAMPLE_RATE_EXACT
+#define AUDIO_SAMPLE_RATE_EXACT 44117.64706f
+#endif
+
+typedef struct audio_block_struct {
+    uint8_t ref_count;
+    uint8_t reserved1;
+    uint16_t memory_pool_index;
+    int16_t data[AUDIO_BLOCK_SAMPLES];
+} audio_block_t;
+
+constexpr int kHostMaxChannels{16};
+extern audio_block_t *hostInputs[kHostMaxChannels];
+extern int16_t hostOutputs[kHostMaxChannels][AUDIO_BLOCK_SAMPLES];
+
+class AudioStream {
+public:
+    AudioStream(unsigned char numInputs, audio_block_t **inputQueue) {}
+
+    virtual ~AudioStream() = default;
+
+    virtual void update() = 0;
+
+protected:
+    static audio_block_t *allocate() {
+        static audio_block_t block;
+        return &block;
+    }
+
+    static void release(audio_block_t *block) {}
+
+    void transmit(audio_block_t *block, unsigned char index = 0) {
+        memcpy(hostOutputs[index], block->data, sizeof(block->data));
+    }
+
+    audio_block_t *receiveReadOnly(unsigned int index = 0) {
+        return hostInputs[index];
+    }
+};
+
+#define AudioNoInterrupts()
+#define AudioInterrupts()
+
+#endif //TEENSY_WFS_TEST_AUDIOSTREAM_H
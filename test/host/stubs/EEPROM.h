@@ -0,0 +1,20 @@
+#ifndef TEENSY_WFS_TEST_EEPROM_H
+#define TEENSY_WFS_TEST_EEPROM_H
+
+// Host stand-in for the Teensy's EEPROM: reads back zeros, so nothing stored
+// is ever found.
+
+class HostEEPROM {
+public:
+    template<class T>
+    T &get(int address, T &value) {
+        return value = T{};
+    }
+
+    template<class T>
+    const T &put(int address, const T &value) { return value; }
+};
+
+extern HostEEPROM EEPROM;
+
+#endif //TEENSY_WFS_TEST_EEPROM_H
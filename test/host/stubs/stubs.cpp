@@ -0,0 +1,10 @@
+#include "Arduino.h"
+#include "AudioStream.h"
+#include "EEPROM.h"
+
+HostSerial Serial;
+HostEEPROM EEPROM;
+volatile uint32_t F_CPU_ACTUAL{600000000};
+volatile uint32_t hostCycleCount{0};
+audio_block_t *hostInputs[kHostMaxChannels]{};
+int16_t hostOutputs[kHostMaxChannels][AUDIO_BLOCK_SAMPLES]{};
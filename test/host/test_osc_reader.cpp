@@ -0,0 +1,207 @@
+/*
+ * OscReader against hand-built packets: messages and bundles as the
+ * controller sends them, the other standard argument types, malformed
+ * packets, and that reading never allocates.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "HostTest.h"
+#include "OscReader.h"
+
+namespace {
+
+int allocations{0};
+
+/**
+ * Builds OSC packets, as the spec, big-endian and padded to four bytes.
+ */
+class Packet {
+public:
+    Packet &string(const char *value) {
+        auto length{strlen(value)};
+        bytes.insert(bytes.end(), value, value + length);
+        bytes.resize(bytes.size() + 4 - length % 4, 0);
+        return *this;
+    }
+
+    Packet &int32(uint32_t value) {
+        for (int shift{24}; shift >= 0; shift -= 8) {
+            bytes.push_back(static_cast<uint8_t>(value >> shift));
+        }
+        return *this;
+    }
+
+    Packet &float32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return int32(bits);
+    }
+
+    Packet &int64(uint64_t value) {
+        return int32(static_cast<uint32_t>(value >> 32)).int32(static_cast<uint32_t>(value));
+    }
+
+    Packet &element(const Packet &content) {
+        int32(static_cast<uint32_t>(content.bytes.size()));
+        bytes.insert(bytes.end(), content.bytes.begin(), content.bytes.end());
+        return *this;
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+Packet bundle(uint64_t timetag) {
+    return Packet().string("#bundle").int64(timetag);
+}
+
+void testMessage() {
+    auto packet{Packet().string("/eq/1/3").string(",sfffff").string("192.168.10.101")
+                        .float32(1.f).float32(-1.5f).float32(.25f).float32(2.f).float32(-.125f)};
+    OscReader reader;
+    OscReader::Message message;
+    EXPECT(reader.read(packet.bytes.data(), static_cast<int>(packet.bytes.size())), "read");
+    EXPECT(!reader.isBundle() && reader.getTimetag() == 1, "not a bundle");
+    EXPECT(reader.next(message), "message");
+    EXPECT(strcmp(message.getAddress(), "/eq/1/3") == 0, "address %s", message.getAddress());
+    EXPECT(message.size() == 6, "%d arguments", message.size());
+    EXPECT(message.getString(0) && strcmp(message.getString(0), "192.168.10.101") == 0, "string");
+    EXPECT(message.getFloat(2) == -1.5f && message.getFloat(5) == -.125f, "floats");
+    EXPECT(message.getFloat(0) == 0.f && message.getString(1) == nullptr, "wrong types");
+    EXPECT(message.getType(6) == 0 && message.getFloat(6) == 0.f, "beyond the arguments");
+    EXPECT(!reader.next(message) && !reader.hasError(), "one message");
+
+    EXPECT(strcmp(message.match("/eq"), "1/3") == 0, "match /eq");
+    EXPECT(message.match("/e") == nullptr, "partial part");
+    EXPECT(message.match("/eq/1/3") && *message.match("/eq/1/3") == '\0', "whole address");
+    EXPECT(message.match("/source") == nullptr, "other prefix");
+}
+
+void testBundle() {
+    const uint64_t timetag{(3900000000ull << 32) | 0x80000000u};
+    auto packet{bundle(timetag)
+                        .element(Packet().string("/source/0/x").string(",f").float32(.25f))
+                        .element(Packet().string("/source/0/y").string(",i").int32(1))
+                        .element(Packet().string("/lod").string(",ff").float32(6.f).float32(2.f))};
+    OscReader reader;
+    OscReader::Message message;
+    EXPECT(reader.read(packet.bytes.data(), static_cast<int>(packet.bytes.size())), "read");
+    EXPECT(reader.isBundle() && reader.getTimetag() == timetag, "timetag");
+    EXPECT(reader.next(message) && strcmp(message.match("/source"), "0/x") == 0, "first");
+    EXPECT(message.getFloat(0) == .25f, "x %f", message.getFloat(0));
+    EXPECT(reader.next(message) && message.getFloat(0) == 1.f && message.getInt(0) == 1, "int as float");
+    EXPECT(reader.next(message) && message.size() == 2 && message.getFloat(1) == 2.f, "third");
+    EXPECT(!reader.next(message) && !reader.hasError(), "three messages");
+}
+
+void testOtherTypes() {
+    // A blob, a double, a 64-bit int, and types without data, between the
+    // arguments read.
+    auto packet{Packet().string("/x").string(",fbdTNhs").float32(3.f)
+                        .int32(5).string("abcd").int64(0).int64(7).string("end")};
+    OscReader reader;
+    OscReader::Message message;
+    EXPECT(reader.read(packet.bytes.data(), static_cast<int>(packet.bytes.size())) && reader.next(message),
+           "read");
+    EXPECT(message.size() == 7 && message.getType(3) == 'T', "%d arguments", message.size());
+    EXPECT(message.getFloat(0) == 3.f, "float");
+    EXPECT(message.getString(6) && strcmp(message.getString(6), "end") == 0, "string after the rest");
+
+    // More arguments than are kept.
+    auto many{Packet().string("/x").string(",iiiiiiiiii")};
+    for (int i{0}; i < 10; ++i) {
+        many.int32(static_cast<uint32_t>(i));
+    }
+    EXPECT(reader.read(many.bytes.data(), static_cast<int>(many.bytes.size())) && reader.next(message),
+           "read");
+    EXPECT(message.size() == OscReader::kMaxArguments && message.getInt(7) == 7, "%d kept", message.size());
+}
+
+void expectMalformed(const char *what, const Packet &packet, int wellFormed) {
+    OscReader reader;
+    OscReader::Message message;
+    int count{0};
+    if (reader.read(packet.bytes.data(), static_cast<int>(packet.bytes.size()))) {
+        while (reader.next(message)) {
+            ++count;
+        }
+    }
+    EXPECT(reader.hasError(), "%s: no error", what);
+    EXPECT(count == wellFormed, "%s: %d messages read", what, count);
+}
+
+void testMalformed() {
+    auto good{Packet().string("/lod").string(",f").float32(1.f)};
+
+    auto truncated{good};
+    truncated.bytes.resize(truncated.bytes.size() - 4);
+    expectMalformed("missing argument", truncated, 0);
+
+    auto unterminated{Packet()};
+    unterminated.bytes.assign(8, 'a');
+    unterminated.bytes[0] = '/';
+    expectMalformed("unterminated address", unterminated, 0);
+
+    expectMalformed("unknown type", Packet().string("/x").string(",q").int32(0), 0);
+    expectMalformed("no comma", Packet().string("/x").string("f").float32(0.f), 0);
+    expectMalformed("not OSC", Packet().string("hello"), 0);
+    expectMalformed("empty", Packet(), 0);
+
+    auto blob{Packet().string("/x").string(",b").int32(100).int32(0)};
+    expectMalformed("oversized blob", blob, 0);
+
+    // Later elements survive a bad one, but not a bad element size.
+    expectMalformed("bad element", bundle(1).element(truncated).element(good), 1);
+    expectMalformed("nested bundle", bundle(1).element(good).element(bundle(1).element(good)).element(good), 2);
+    auto overrun{bundle(1).element(good)};
+    overrun.int32(1000).int32(0);
+    expectMalformed("element overrun", overrun, 1);
+    auto misaligned{bundle(1).element(good)};
+    misaligned.int32(3).int32(0);
+    expectMalformed("misaligned element", misaligned, 1);
+}
+
+void testNoAllocation() {
+    auto packet{bundle(2)
+                        .element(Packet().string("/source/0/x").string(",f").float32(.25f))
+                        .element(Packet().string("/module/3").string(",s").string("192.168.10.103"))};
+    OscReader reader;
+    OscReader::Message message;
+    auto before{allocations};
+    for (int i{0}; i < 100; ++i) {
+        reader.read(packet.bytes.data(), static_cast<int>(packet.bytes.size()));
+        while (reader.next(message)) {
+        }
+    }
+    printf("100 reads of a two-message bundle: %d allocations\n", allocations - before);
+    EXPECT(allocations == before, "%d allocations", allocations - before);
+}
+
+}
+
+void *operator new(size_t size) {
+    ++allocations;
+    if (auto *p = malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+int main() {
+    testMessage();
+    testBundle();
+    testOtherTypes();
+    testMalformed();
+    testNoAllocation();
+    return hostTestFailures();
+}
@@ -0,0 +1,41 @@
+/*
+ * The renderer against the Faust-generated DSP, via RenderCheck, as the
+ * device's boot-time self-check (WFS_SELF_CHECK) but at each supported
+ * sampling rate: exact mode to rounding, and shared-filter mode to its
+ * approximation, neither moving anything in time.
+ */
+
+#include <memory>
+#include "HostTest.h"
+#include "WFS.cpp"
+#include "RenderCheck.h"
+
+namespace {
+
+void check(const char *mode, float sharedFilter, int sampleRate, const wfs::RenderCheck::Tolerance &tolerance) {
+    std::unique_ptr<mydsp> reference{new mydsp()};
+    std::unique_ptr<wfs_renderer_dsp> candidate{new wfs_renderer_dsp()};
+    *candidate->getRenderer().getSharedFilterZone() = sharedFilter;
+
+    wfs::RenderCheck::Result results[wfs::RenderCheck::kNumResults];
+    wfs::RenderCheck::run(*reference, *candidate, sampleRate, tolerance, results);
+
+    for (const auto &result: results) {
+        printf("%s, %d Hz, %-7s speaker %d: max error %e, SNR %.1f dB, lag %d\n",
+               mode, sampleRate, wfs::RenderCheck::getSignalName(result.signal), result.speaker,
+               result.maxError, result.snr, result.lag);
+        EXPECT(result.passed, "%s, %d Hz, %s, speaker %d", mode, sampleRate,
+               wfs::RenderCheck::getSignalName(result.signal), result.speaker);
+    }
+}
+
+}
+
+int main() {
+    for (auto sampleRate: {44100, 48000}) {
+        // As WFS::runSelfCheck().
+        check("exact", 0.f, sampleRate, {1e-4f, 100.f, 0});
+        check("shared filter", 1.f, sampleRate, {.25f, 15.f, 0});
+    }
+    return hostTestFailures();
+}
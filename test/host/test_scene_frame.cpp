@@ -0,0 +1,86 @@
+/*
+ * SceneFrame encoding and decoding: a round trip of every field, the masks
+ * for the highest source, and frames that must be rejected.
+ */
+
+#include <cmath>
+#include "HostTest.h"
+#include "SceneFrame.h"
+
+namespace {
+
+void testRoundTrip() {
+    SceneFrame out;
+    out.session = 0xdeadbeef;
+    out.sequence = 0xfffffffe;
+    out.timetag = (3900000000ull << 32) | 0x80000000u;
+    out.numSources = 5;
+    out.valid = SceneFrame::bit(0) | SceneFrame::bit(2) | SceneFrame::bit(4);
+    out.changed = SceneFrame::bit(2);
+    out.x[2] = .25f;
+    out.y[2] = 1.f;
+    out.x[4] = 0.f;
+    out.y[4] = .5f;
+
+    uint8_t buffer[SceneFrame::kMaxSize];
+    auto size{out.encode(buffer, sizeof(buffer))};
+    EXPECT(size == SceneFrame::getSize(5) && size == 60, "%d bytes", size);
+    EXPECT(SceneFrame::isFrame(buffer, size), "magic");
+
+    SceneFrame in;
+    EXPECT(in.decode(buffer, size), "decode");
+    EXPECT(in.session == out.session && in.sequence == out.sequence && in.timetag == out.timetag,
+           "header");
+    EXPECT(in.valid == out.valid && in.changed == out.changed, "masks");
+    EXPECT(in.numSources == 5, "%d sources", in.numSources);
+    // Quantised to 1/65535.
+    EXPECT(std::abs(in.x[2] - .25f) < 1.f / 65535.f, "x %f", in.x[2]);
+    EXPECT(in.y[2] == 1.f && in.x[4] == 0.f, "exact ends");
+    EXPECT(std::abs(in.y[4] - .5f) < 1.f / 65535.f, "y %f", in.y[4]);
+}
+
+void testHighestSource() {
+    SceneFrame out;
+    out.numSources = SceneFrame::kMaxSources;
+    out.valid = out.changed = SceneFrame::bit(SceneFrame::kMaxSources - 1);
+    out.x[SceneFrame::kMaxSources - 1] = .75f;
+
+    uint8_t buffer[SceneFrame::kMaxSize];
+    SceneFrame in;
+    EXPECT(in.decode(buffer, out.encode(buffer, sizeof(buffer))), "decode");
+    EXPECT(in.valid == SceneFrame::bit(63) && in.changed == in.valid, "top bit");
+    EXPECT(std::abs(in.x[63] - .75f) < 1.f / 65535.f, "x %f", in.x[63]);
+}
+
+void testRejected() {
+    SceneFrame out;
+    out.numSources = 4;
+    uint8_t buffer[SceneFrame::kMaxSize];
+    auto size{out.encode(buffer, sizeof(buffer))};
+    SceneFrame in;
+
+    EXPECT(!in.decode(buffer, size - 1), "truncated");
+    EXPECT(!in.decode(buffer, SceneFrame::kHeaderSize - 1), "short header");
+    buffer[4] = 1;
+    EXPECT(!in.decode(buffer, size), "version 1");
+    buffer[4] = SceneFrame::kVersion;
+    buffer[5] = SceneFrame::kMaxSources + 1;
+    EXPECT(!in.decode(buffer, size), "too many sources");
+
+    out.numSources = SceneFrame::kMaxSources + 1;
+    EXPECT(out.encode(buffer, sizeof(buffer)) == 0, "encoded too many sources");
+    out.numSources = 4;
+    EXPECT(out.encode(buffer, SceneFrame::getSize(4) - 1) == 0, "encoded into too small a buffer");
+
+    const char osc[]{"/source/0/x"};
+    EXPECT(!SceneFrame::isFrame(reinterpret_cast<const uint8_t *>(osc), SceneFrame::kHeaderSize), "OSC");
+}
+
+}
+
+int main() {
+    testRoundTrip();
+    testHighestSource();
+    testRejected();
+    return hostTestFailures();
+}
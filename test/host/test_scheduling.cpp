@@ -0,0 +1,256 @@
+/*
+ * Scheduled source positions: that an untagged position supersedes scheduled
+ * ones, that positions beyond what the schedule holds are counted, and, for
+ * several nodes receiving the same timetagged bundles over a jittery network,
+ * each with its own boot time and clock rate, that each node applies every
+ * move at the sample ClockSync gives it (in subband mode, at the start of the
+ * four samples holding it), and how closely the nodes agree.
+ *
+ * Only one WFS can exist at a time (its memory is static), so the nodes are
+ * emulated one after another, over the same bundles.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "HostTest.h"
+#include "WFS.cpp"
+#include "ClockSync.h"
+
+namespace {
+
+constexpr double kSampleRate{AUDIO_SAMPLE_RATE_EXACT};
+constexpr int kNumNodes{8};
+// The controller's clock, at the first bundle; NTP seconds.
+constexpr double kEpoch{3.9e9};
+// Seconds of bundles, one per move, and of settling, excluded from the
+// spread, while the nodes' clock offset estimates fill their first window.
+// The controller sends a frame per change, so at about the UI's frame rate
+// while a source is dragged.
+constexpr double kDuration{60.}, kSettleTime{5.}, kMovePeriod{1. / 30.};
+constexpr int16_t kInputLevel{16000};
+// Clock rates within this of nominal, and ClockSync's window, in seconds.
+constexpr double kMaxDrift{30e-6}, kWindow{2.};
+// Subband mode splits blocks at multiples of its decimation factor.
+constexpr int kSubbandGranularity{4};
+
+audio_block_t dcBlock;
+
+void setCycles(uint64_t sampleTime, double into) {
+    // As the cycle counter, wrapping.
+    const double cyclesPerSample{F_CPU_ACTUAL / AUDIO_SAMPLE_RATE_EXACT};
+    hostCycleCount = static_cast<uint32_t>(static_cast<uint64_t>(sampleTime * cyclesPerSample) +
+                                           static_cast<uint64_t>(into * cyclesPerSample));
+}
+
+uint64_t toTimetag(double seconds) {
+    // Microsecond resolution, as the controller's.
+    auto whole{std::floor(seconds)};
+    auto micros{std::floor((seconds - whole) * 1e6)};
+    return (static_cast<uint64_t>(whole) << 32) | static_cast<uint64_t>(micros * 1e-6 * 4294967296.);
+}
+
+float positionY(int move) {
+    return move % 2 ? .2f : .1f;
+}
+
+void testUntaggedSupersedes() {
+    std::unique_ptr<WFS> wfs{new WFS()};
+    wfs->update();
+    wfs->setSourcePosition(0, .5f, .8f, AUDIO_BLOCK_SAMPLES * 4);
+    wfs->commitSourcePositions();
+    wfs->update();
+    wfs->setSourcePosition(0, .5f, .3f);
+    wfs->commitSourcePositions();
+    for (int b{0}; b < 8; ++b) {
+        wfs->update();
+    }
+    EXPECT(wfs->getParamValue("0/y") == .3f, "y %f after the scheduled time", wfs->getParamValue("0/y"));
+    auto stats{wfs->getPositionQueueStats()};
+    EXPECT(stats.applied == 1, "%u applied", (unsigned) stats.applied);
+}
+
+void testScheduleFull() {
+    std::unique_ptr<WFS> wfs{new WFS()};
+    wfs->update();
+    const int count{80};
+    for (int i{0}; i < count; ++i) {
+        wfs->setSourcePosition(i % NUM_SOURCES, .5f, .01f * i, 10000 + i);
+        wfs->commitSourcePositions();
+        if (i % NUM_SOURCES == NUM_SOURCES - 1) {
+            wfs->update();
+        }
+    }
+    auto stats{wfs->getPositionQueueStats()};
+    EXPECT(stats.early == count - 64, "%u early", (unsigned) stats.early);
+    EXPECT(stats.applied == count - 64, "%u applied before their time", (unsigned) stats.applied);
+    while (wfs->getSampleTime() < 10000 + count) {
+        wfs->update();
+    }
+    stats = wfs->getPositionQueueStats();
+    EXPECT(stats.applied == count, "%u applied", (unsigned) stats.applied);
+    EXPECT(stats.late == 0, "%u late", (unsigned) stats.late);
+}
+
+struct Node {
+    double boot;
+    // Sample clock rate relative to nominal.
+    double rate;
+    // When the node applied each move, as the controller's clock.
+    std::vector<double> applied;
+};
+
+/**
+ * Runs a node through every bundle, recording when its output changes.
+ * @return Moves not applied at exactly the scheduled sample (in subband mode,
+ * rounded down to the renderer's split granularity).
+ */
+int runNode(Node &node, int index, const std::vector<double> &sent, bool subband) {
+    std::mt19937 rng(100 + index);
+    std::exponential_distribution<double> jitter(1. / 300e-6);
+    std::uniform_real_distribution<double> loop(0., 1e-3);
+
+    // Arrival times, in samples on the node's clock.
+    std::vector<double> arrivals;
+    for (auto t: sent) {
+        auto arrival{t + 100e-6 + jitter(rng) + loop(rng)};
+        arrivals.push_back((arrival - kEpoch - node.boot) * kSampleRate * node.rate);
+    }
+
+    std::unique_ptr<WFS> wfs{new WFS()};
+    wfs->setModuleID(3);
+    wfs->setParamValue("subband", subband ? 1.f : 0.f);
+    const uint64_t granularity{subband ? kSubbandGranularity : 1u};
+    // The low band is brought back up to the full rate by linear
+    // interpolation, from the previous low band sample; so a change shows
+    // from the second sample of the four it's applied at, and ramps in.
+    const uint64_t interpolationLag{subband ? 1u : 0u};
+    ClockSync sync{static_cast<float>(kSampleRate), .02f, static_cast<float>(kWindow)};
+    wfs->setSourcePosition(0, .43f, positionY(1));
+    wfs->commitSourcePositions();
+
+    // The sample at which each move is scheduled, and found to apply.
+    std::vector<uint64_t> scheduled(sent.size(), 0);
+    node.applied.assign(sent.size(), 0.);
+    size_t nextArrival{0}, pending{0};
+    int16_t previous{0};
+    int mismatches{0};
+
+    const auto end{static_cast<uint64_t>(arrivals.back() + kSampleRate)};
+    for (uint64_t blockTime{0}; blockTime < end; blockTime += AUDIO_BLOCK_SAMPLES) {
+        setCycles(blockTime, 0.);
+        wfs->update();
+
+        for (int n{0}; n < AUDIO_BLOCK_SAMPLES; ++n) {
+            auto sample{hostOutputs[0][n]};
+            if (pending < nextArrival && std::abs(sample - previous) > 1) {
+                auto expected{scheduled[pending] - scheduled[pending] % granularity + interpolationLag};
+                if (blockTime + n != expected) {
+                    ++mismatches;
+                    printf("node %d, move %zu: expected at %llu, applied at %llu\n", index, pending,
+                           (unsigned long long) expected, (unsigned long long) (blockTime + n));
+                }
+                node.applied[pending] = kEpoch + node.boot +
+                                        static_cast<double>(blockTime + n) / (kSampleRate * node.rate);
+                ++pending;
+            }
+            previous = sample;
+        }
+
+        // Bundles that arrive while this block plays, as loop() would handle
+        // them.
+        while (nextArrival < arrivals.size() &&
+               arrivals[nextArrival] < static_cast<double>(blockTime + AUDIO_BLOCK_SAMPLES)) {
+            setCycles(blockTime, arrivals[nextArrival] - static_cast<double>(blockTime));
+            auto timetag{toTimetag(sent[nextArrival])};
+            sync.observe(timetag, wfs->getSampleTime());
+            scheduled[nextArrival] = sync.schedule(timetag);
+            wfs->setSourcePosition(0, .43f, positionY(static_cast<int>(nextArrival)), scheduled[nextArrival]);
+            wfs->commitSourcePositions();
+            ++nextArrival;
+        }
+    }
+
+    auto stats{wfs->getPositionQueueStats()};
+    EXPECT(pending == sent.size(), "node %d: %zu of %zu moves seen", index, pending, sent.size());
+    EXPECT(stats.late == 0 && stats.early == 0, "node %d: %u late, %u early", index,
+           (unsigned) stats.late, (unsigned) stats.early);
+    return mismatches;
+}
+
+void testNodesAgree(bool subband) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> boot(0., 5.), ppm(-kMaxDrift, kMaxDrift);
+
+    std::vector<double> sent;
+    for (double t{10.}; t < 10. + kDuration; t += kMovePeriod) {
+        sent.push_back(kEpoch + t);
+    }
+
+    hostInputs[0] = &dcBlock;
+    std::fill(std::begin(dcBlock.data), std::end(dcBlock.data), kInputLevel);
+
+    std::vector<Node> nodes(kNumNodes);
+    int mismatches{0};
+    for (int i{0}; i < kNumNodes; ++i) {
+        nodes[i].boot = boot(rng);
+        nodes[i].rate = 1. + ppm(rng);
+        mismatches += runNode(nodes[i], i, sent, subband);
+    }
+    hostInputs[0] = nullptr;
+    EXPECT(mismatches == 0, "%d moves applied off their scheduled sample", mismatches);
+
+    // Spread of each move across the nodes, in samples.
+    double worst{0.}, sum{0.};
+    int count{0};
+    for (size_t m{0}; m < sent.size(); ++m) {
+        if (sent[m] < kEpoch + 10. + kSettleTime) {
+            continue;
+        }
+        auto earliest{nodes[0].applied[m]}, latest{earliest};
+        for (const auto &node: nodes) {
+            earliest = std::min(earliest, node.applied[m]);
+            latest = std::max(latest, node.applied[m]);
+        }
+        auto spread{(latest - earliest) * kSampleRate};
+        worst = std::max(worst, spread);
+        sum += spread;
+        ++count;
+    }
+    printf("%s: %d moves across %d nodes: spread mean %.2f, worst %.2f samples\n",
+           subband ? "subband" : "exact", count, kNumNodes, sum / count, worst);
+
+    // What the clock model allows. Each node's offset estimate is the
+    // smallest arrival-minus-timetag difference over up to two windows, so:
+    // - a node running fast of the controller has an estimate up to two
+    //   windows stale, and applies moves up to that much drift early (5.3
+    //   samples);
+    // - the smallest network delay over a window (30 bundles a second, each
+    //   0.1 ms plus an exponential of mean 0.3 ms plus up to 1 ms) is under
+    //   0.2 ms (8.8 samples) in about 96% of windows, and under 0.1 ms in
+    //   half of them;
+    // - timetags to the microsecond, and arrivals to the sample, round by up
+    //   to a sample each;
+    // - in subband mode, splitting to a multiple of four samples rounds down
+    //   by up to three.
+    const double drift{2. * kWindow * kMaxDrift * kSampleRate};
+    const double rounding{2. + (subband ? kSubbandGranularity - 1 : 0)};
+    const double worstBound{drift + 200e-6 * kSampleRate + rounding};
+    // The model bounds the extremes, not the mean; this is just above what
+    // was measured (6.6 and 7.3 samples), to catch it getting worse.
+    const double meanBound{subband ? 7.5 : 7.};
+    EXPECT(sum / count < meanBound, "mean spread %.2f samples, over %.2f", sum / count, meanBound);
+    EXPECT(worst < worstBound, "worst spread %.2f samples, over %.2f", worst, worstBound);
+}
+
+}
+
+int main() {
+    testUntaggedSupersedes();
+    testScheduleFull();
+    testNodesAgree(false);
+    testNodesAgree(true);
+    return hostTestFailures();
+}
@@ -0,0 +1,160 @@
+/*
+ * How far the shared distance filter's cutoff (one lowpass per source per
+ * module, designed for the module centre) strays from the exact per-speaker
+ * cutoffs, over a grid of source positions covering the listening area, for
+ * every module of the default array; and that, with anti-aliasing on, which
+ * the shared filter can't follow, the shared filter and subband modes render
+ * exactly instead.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "HostTest.h"
+#include "ArrayGeometry.h"
+#include "WFSRenderer.h"
+
+namespace {
+
+constexpr int kGridSize{201};
+constexpr float kSampleRate{44100.f};
+
+struct Errors {
+    // Cents; positive where the shared cutoff is higher.
+    std::vector<float> cents;
+    float worstHz{0.f};
+    float worstCents{0.f};
+    float worstExactCutoff{0.f};
+};
+
+float percentile(std::vector<float> values, float p) {
+    auto index{static_cast<size_t>(p * static_cast<float>(values.size() - 1))};
+    std::nth_element(values.begin(), values.begin() + static_cast<long>(index), values.end());
+    return values[index];
+}
+
+Errors sweep() {
+    ArrayGeometry geometry;
+    // As the renderer, limited to below Nyquist.
+    const float maxCutoff{.49f * kSampleRate};
+    Errors errors;
+
+    for (int module{0}; module < NUM_SPEAKERS / SPEAKERS_PER_MODULE; ++module) {
+        // The module centre, as WFSRenderer::updateSpeakers().
+        float cx{0.f}, cy{0.f}, cnx{0.f}, cny{0.f}, cSpacing{0.f};
+        for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+            const auto index{module * SPEAKERS_PER_MODULE + k};
+            const auto &s{geometry.getSpeaker(index)};
+            cx += s.x / SPEAKERS_PER_MODULE;
+            cy += s.y / SPEAKERS_PER_MODULE;
+            cnx += s.nx;
+            cny += s.ny;
+            cSpacing += geometry.getSpacing(index) / SPEAKERS_PER_MODULE;
+        }
+        const auto norm{std::sqrt(cnx * cnx + cny * cny)};
+        cnx /= norm;
+        cny /= norm;
+
+        for (int i{0}; i < kGridSize; ++i) {
+            for (int j{0}; j < kGridSize; ++j) {
+                // Normalised co-ordinates scaled as the renderer's.
+                const auto x{static_cast<float>(i) / (kGridSize - 1) * SPEAKER_DIST * NUM_SPEAKERS};
+                const auto y{static_cast<float>(j) / (kGridSize - 1) * MAX_Y_DIST};
+
+                const auto dxc{x - cx}, dyc{y - cy};
+                const auto shared{std::min(maxCutoff, WFSRenderer::computeCutoff(
+                        std::sqrt(dxc * dxc + dyc * dyc), std::fabs(cnx * dyc - cny * dxc), cSpacing, false))};
+
+                for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+                    const auto index{module * SPEAKERS_PER_MODULE + k};
+                    const auto &s{geometry.getSpeaker(index)};
+                    const auto dx{x - s.x}, dy{y - s.y};
+                    const auto exact{std::min(maxCutoff, WFSRenderer::computeCutoff(
+                            std::sqrt(dx * dx + dy * dy), std::fabs(s.nx * dy - s.ny * dx),
+                            geometry.getSpacing(index), false))};
+
+                    const auto cents{1200.f * std::log2(shared / exact)};
+                    errors.cents.push_back(cents);
+                    if (std::fabs(cents) > std::fabs(errors.worstCents)) {
+                        errors.worstCents = cents;
+                        errors.worstHz = shared - exact;
+                        errors.worstExactCutoff = exact;
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+void checkCutoffs(float maxWorst, float maxP99, float maxMedian) {
+    auto errors{sweep()};
+    std::vector<float> magnitudes(errors.cents.size());
+    std::transform(errors.cents.begin(), errors.cents.end(), magnitudes.begin(),
+                   [](float c) { return std::fabs(c); });
+    const auto median{percentile(magnitudes, .5f)};
+    const auto p99{percentile(magnitudes, .99f)};
+    printf("%zu source/speaker pairs; |error| median %.2f, 99th percentile %.2f, "
+           "worst %.2f cents (%.0f Hz at %.0f Hz)\n",
+           magnitudes.size(), median, p99, errors.worstCents,
+           errors.worstHz, errors.worstExactCutoff);
+    EXPECT(std::fabs(errors.worstCents) <= maxWorst, "worst %.2f cents", errors.worstCents);
+    EXPECT(p99 <= maxP99, "99th percentile %.2f cents", p99);
+    EXPECT(median <= maxMedian, "median %.2f cents", median);
+}
+
+/**
+ * Renders noise from sources spread over the listening area, moving each
+ * block, with anti-aliasing on and the given mode.
+ */
+std::vector<float> renderAntiAliased(float sharedFilter, float subband) {
+    std::unique_ptr<WFSRenderer> renderer{new WFSRenderer()};
+    renderer->init(static_cast<int>(kSampleRate));
+    *renderer->getAntiAliasZone() = 1.f;
+    *renderer->getSharedFilterZone() = sharedFilter;
+    *renderer->getSubbandZone() = subband;
+    *renderer->getModuleIDZone() = 3.f;
+
+    float inBuffer[NUM_SOURCES][AUDIO_BLOCK_SAMPLES], outBuffer[SPEAKERS_PER_MODULE][AUDIO_BLOCK_SAMPLES];
+    float *inputs[NUM_SOURCES], *outputs[SPEAKERS_PER_MODULE];
+    for (int s{0}; s < NUM_SOURCES; ++s) {
+        inputs[s] = inBuffer[s];
+    }
+    for (int k{0}; k < SPEAKERS_PER_MODULE; ++k) {
+        outputs[k] = outBuffer[k];
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-.5f, .5f);
+    std::vector<float> rendered;
+    for (int b{0}; b < 200; ++b) {
+        for (int s{0}; s < NUM_SOURCES; ++s) {
+            *renderer->getSourceXZone(s) = static_cast<float>((b + s * 13) % 100) / 100.f;
+            *renderer->getSourceYZone(s) = static_cast<float>((b / 2 + s * 29) % 100) / 100.f;
+            for (auto &sample: inBuffer[s]) {
+                sample = noise(rng);
+            }
+        }
+        renderer->compute(AUDIO_BLOCK_SAMPLES, inputs, outputs);
+        for (const auto &channel: outBuffer) {
+            rendered.insert(rendered.end(), std::begin(channel), std::end(channel));
+        }
+    }
+    return rendered;
+}
+
+void checkAntiAliasRendersExactly() {
+    const auto exact{renderAntiAliased(0.f, 0.f)};
+    EXPECT(renderAntiAliased(1.f, 0.f) == exact, "shared filter with anti-aliasing differs from exact");
+    EXPECT(renderAntiAliased(0.f, 1.f) == exact, "subband with anti-aliasing differs from exact");
+}
+
+}
+
+int main() {
+    checkCutoffs(60.f, 46.f, 3.5f);
+    checkAntiAliasRendersExactly();
+    return hostTestFailures();
+}
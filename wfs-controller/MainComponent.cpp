@@ -13,6 +13,10 @@ MainComponent::MainComponent(ValueTree &tree) :
         valueTree.setProperty("/source/" + String{nodeIndex} + "/x", position.x, nullptr);
         valueTree.setProperty("/source/" + String{nodeIndex} + "/y", position.y, nullptr);
     };
+    xyController.onGainChange = [this](uint nodeIndex, float gain, bool muted) {
+        valueTree.setProperty("/source/" + String{nodeIndex} + "/gain", gain, nullptr);
+        valueTree.setProperty("/source/" + String{nodeIndex} + "/mute", muted ? 1.f : 0.f, nullptr);
+    };
     xyController.onAddNode = [this](uint nodeIndex) { addSource(nodeIndex); };
     xyController.onRemoveNode = [this](uint nodeIndex) { removeSource(nodeIndex); };
 
@@ -60,6 +64,15 @@ MainComponent::MainComponent(ValueTree &tree) :
     gainLabel.setText("Gain", dontSendNotification);
     gainLabel.setColour(Label::textColourId, fg);
 
+    addAndMakeVisible(preEqualisationToggle);
+    preEqualisationToggle.setButtonText("Pre-EQ");
+    preEqualisationToggle.onClick = [this] {
+        multiChannelSource->setPreEqualisation(preEqualisationToggle.getToggleState());
+    };
+    preEqualisationToggle.setColour(ToggleButton::textColourId, fg);
+    preEqualisationToggle.setColour(ToggleButton::tickColourId, fg);
+    preEqualisationToggle.setColour(ToggleButton::tickDisabledColourId, fg);
+
     setSize(1080, 800);
 
     setAudioChannels(0, NUM_AUDIO_SOURCES);
@@ -137,6 +150,7 @@ void MainComponent::resized() {
     settingsButton.setBounds(padding, bounds.getBottom() - padding - 20, 60, 20);
     connectToModulesButton.setBounds(xyController.getRight() - 100, xyController.getY() - 25, 100, 20);
     gainSlider.setBounds(xyController.getX() + 35, xyController.getY() - 25, 250, 20);
+    preEqualisationToggle.setBounds(gainSlider.getRight() + padding, gainSlider.getY(), 80, 20);
 }
 
 void MainComponent::showSettings() {
@@ -52,6 +52,8 @@ private:
     Slider gainSlider;
     Label gainLabel;
 
+    ToggleButton preEqualisationToggle;
+
     TextButton connectToModulesButton;
 
     std::unique_ptr<MultiChannelAudioSource> multiChannelSource;
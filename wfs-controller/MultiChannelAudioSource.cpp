@@ -16,6 +16,8 @@ void MultiChannelAudioSource::prepareToPlay(int samplesPerBlockExpected, double
     blockSize = samplesPerBlockExpected;
     sampleRate = sampleRateToUse;
 
+    preEqualiser.prepare(sampleRate);
+
     isPrepared = true;
 }
 
@@ -51,6 +53,9 @@ void MultiChannelAudioSource::getNextAudioBlock(const AudioSourceChannelInfo &bu
             }
         }
 
+        // Pre-equalise each source once here, rather than on every module.
+        preEqualiser.process(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
         if (!playing) {
             DBG("MultiChannelAudioSource: Just stopped playing...");
             // just stopped playing, so fade out the last block...
@@ -181,4 +186,8 @@ bool MultiChannelAudioSource::canAddSource() {
 void MultiChannelAudioSource::setGain(float newGain) {
     lastGain = gain;
     gain = newGain;
+}
+
+void MultiChannelAudioSource::setPreEqualisation(bool enable) {
+    preEqualiser.setEnabled(enable);
 }
\ No newline at end of file
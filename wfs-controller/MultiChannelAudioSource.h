@@ -7,6 +7,7 @@
 
 #include <JuceHeader.h>
 #include "Utils.h"
+#include "PreEqualiser.h"
 
 class MultiChannelAudioSource : public PositionableAudioSource, public ChangeBroadcaster {
 public:
@@ -36,12 +37,19 @@ public:
 
     void setGain(float newGain);
 
+    /**
+     * Enable/disable WFS pre-equalisation of each source before it's sent to
+     * the modules.
+     */
+    void setPreEqualisation(bool enable);
+
 private:
     bool canAddSource();
 
     AudioFormatManager formatManager;
     std::unordered_map<uint, std::unique_ptr<AudioFormatReaderSource>> sources;
     AudioBuffer<float> tempBuffer;
+    PreEqualiser preEqualiser{NUM_AUDIO_SOURCES};
 
     CriticalSection lock;
 
@@ -0,0 +1,106 @@
+#include "PreEqualiser.h"
+
+PreEqualiser::PreEqualiser(int maxNumChannels) :
+        numGroups((maxNumChannels + NUM_LANES - 1) / NUM_LANES),
+        state(static_cast<size_t>(numGroups * NUM_SECTIONS)) {
+    prepare(48000.);
+}
+
+void PreEqualiser::prepare(double sampleRate) {
+    auto fs{static_cast<float>(sampleRate)};
+    auto k{2.f * fs};
+    // Upper corner: spatial aliasing frequency of the array.
+    auto highFrequency{jmin(SPEED_OF_SOUND / (2.f * SPEAKER_DIST), .45f * fs)};
+    // Per-section frequency ratio; each section contributes a zero and, half
+    // a step (in log frequency) higher, a pole, for an average of 3 dB/octave.
+    auto ratio{std::pow(highFrequency / LOW_FREQUENCY, 1.f / NUM_SECTIONS)};
+
+    for (int i{0}; i < NUM_SECTIONS; ++i) {
+        auto zero{LOW_FREQUENCY * std::pow(ratio, static_cast<float>(i))};
+        auto pole{zero * std::sqrt(ratio)};
+        // Pre-warped corners for the bilinear transform.
+        auto wz{k * std::tan(MathConstants<float>::pi * zero / fs)};
+        auto wp{k * std::tan(MathConstants<float>::pi * pole / fs)};
+        // H(s) = (s + wz) / (s + wp); unity gain at high frequencies.
+        auto norm{1.f / (k + wp)};
+        b0[i] = Vec::expand((k + wz) * norm);
+        b1[i] = Vec::expand((wz - k) * norm);
+        a1[i] = Vec::expand((wp - k) * norm);
+    }
+
+    reset();
+}
+
+void PreEqualiser::reset() {
+    std::fill(state.begin(), state.end(), Vec::expand(0.f));
+}
+
+void PreEqualiser::process(AudioBuffer<float> &buffer, int startSample, int numSamples) {
+    if (!enabled) {
+        return;
+    }
+
+    if (resetPending.exchange(false)) {
+        reset();
+    }
+
+    auto numChannels{jmin(buffer.getNumChannels(), numGroups * NUM_LANES)};
+    // Tiles of samples, interleaved by lane, so that the filter loads and
+    // stores whole registers; channels are copied in and out in contiguous
+    // runs, not gathered a sample at a time. Several groups are filtered
+    // together, as each section waits on the last.
+    alignas(Vec::SIMDRegisterSize) float tile[GROUPS_PER_TILE][TILE_SAMPLES * NUM_LANES];
+
+    for (int firstGroup{0}; firstGroup * NUM_LANES < numChannels; firstGroup += GROUPS_PER_TILE) {
+        auto firstChannel{firstGroup * NUM_LANES};
+        auto tileChannels{jmin(GROUPS_PER_TILE * NUM_LANES, numChannels - firstChannel)};
+        auto tileGroups{(tileChannels + NUM_LANES - 1) / NUM_LANES};
+        // The last group's unused lanes stay silent.
+        std::fill(&tile[tileGroups - 1][0], &tile[tileGroups - 1][0] + TILE_SAMPLES * NUM_LANES, 0.f);
+
+        for (int start{0}; start < numSamples; start += TILE_SAMPLES) {
+            auto tileSamples{jmin(TILE_SAMPLES, numSamples - start)};
+
+            for (int c{0}; c < tileChannels; ++c) {
+                auto *channel{buffer.getWritePointer(firstChannel + c, startSample + start)};
+                auto *lanes{&tile[c / NUM_LANES][c % NUM_LANES]};
+                for (int n{0}; n < tileSamples; ++n) {
+                    lanes[n * NUM_LANES] = channel[n];
+                }
+            }
+
+            for (int n{0}; n < tileSamples; ++n) {
+                for (int g{0}; g < tileGroups; ++g) {
+                    auto *s{&state[static_cast<size_t>((firstGroup + g) * NUM_SECTIONS)]};
+                    auto x{Vec::fromRawArray(&tile[g][n * NUM_LANES])};
+                    for (int i{0}; i < NUM_SECTIONS; ++i) {
+                        auto y{b0[i] * x + s[i]};
+                        s[i] = b1[i] * x - a1[i] * y;
+                        x = y;
+                    }
+                    x.copyToRawArray(&tile[g][n * NUM_LANES]);
+                }
+            }
+
+            for (int c{0}; c < tileChannels; ++c) {
+                auto *channel{buffer.getWritePointer(firstChannel + c, startSample + start)};
+                const auto *lanes{&tile[c / NUM_LANES][c % NUM_LANES]};
+                for (int n{0}; n < tileSamples; ++n) {
+                    channel[n] = lanes[n * NUM_LANES];
+                }
+            }
+        }
+    }
+}
+
+void PreEqualiser::setEnabled(bool shouldBeEnabled) {
+    if (shouldBeEnabled && !enabled) {
+        // Don't resume with stale state; cleared on the audio thread.
+        resetPending = true;
+    }
+    enabled = shouldBeEnabled;
+}
+
+bool PreEqualiser::isEnabled() const {
+    return enabled;
+}
@@ -0,0 +1,53 @@
+#ifndef JACKTRIP_TEENSY_PREEQUALISER_H
+#define JACKTRIP_TEENSY_PREEQUALISER_H
+
+#include <JuceHeader.h>
+#include "Utils.h"
+
+/**
+ * WFS (2.5D) pre-equalisation: a +3 dB/octave slope, identical for every
+ * speaker, so it is applied once per source here rather than on every module.
+ *
+ * The slope is approximated by a cascade of first-order shelves with
+ * alternating, geometrically-spaced zeros and poles, between LOW_FREQUENCY
+ * and the array's spatial aliasing frequency; it is flat (0 dB) above the
+ * aliasing frequency and attenuates below it, so the filter can't clip.
+ *
+ * Sources are processed in parallel, one per SIMD lane, a tile of samples at
+ * a time.
+ */
+class PreEqualiser {
+public:
+    explicit PreEqualiser(int maxNumChannels);
+
+    void prepare(double sampleRate);
+
+    void reset();
+
+    void process(AudioBuffer<float> &buffer, int startSample, int numSamples);
+
+    void setEnabled(bool shouldBeEnabled);
+
+    bool isEnabled() const;
+
+private:
+    using Vec = dsp::SIMDRegister<float>;
+
+    static constexpr int NUM_SECTIONS{4};
+    static constexpr int NUM_LANES{static_cast<int>(Vec::SIMDNumElements)};
+    // Samples per channel filtered at a time; see process().
+    static constexpr int TILE_SAMPLES{64};
+    static constexpr int GROUPS_PER_TILE{4};
+    static constexpr float LOW_FREQUENCY{50.f};
+    static constexpr float SPEED_OF_SOUND{343.f};
+
+    int numGroups;
+    // First-order sections: y = b0*x + s; s = b1*x - a1*y
+    Vec b0[NUM_SECTIONS], b1[NUM_SECTIONS], a1[NUM_SECTIONS];
+    std::vector<Vec> state;
+
+    std::atomic<bool> enabled{false}, resetPending{false};
+};
+
+
+#endif //JACKTRIP_TEENSY_PREEQUALISER_H
@@ -25,4 +25,8 @@
 #define SPEAKERS_PER_MODULE 2
 #endif
 
+#ifndef SPEAKER_DIST
+#define SPEAKER_DIST .23f
+#endif
+
 #endif //JACKTRIP_TEENSY_UTILS_H
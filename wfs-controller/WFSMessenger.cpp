@@ -3,15 +3,24 @@
 //
 
 #include "WFSMessenger.h"
+#include <chrono>
 
 WFSMessenger::WFSMessenger(ValueTree &tree) :
         socket(std::make_unique<DatagramSocket>()),
         valueTree(tree) {
+    // A new session each run, so nodes don't take this run's frames for
+    // stale ones from the last.
+    sceneOut.session = static_cast<uint32>(Random::getSystemRandom().nextInt());
+    for (int source{0}; source < SceneFrame::kMaxSources; ++source) {
+        updateScenePosition(source);
+    }
+    sceneOut.changed = 0;
     valueTree.addListener(this);
 }
 
 WFSMessenger::~WFSMessenger() {
     valueTree.removeListener(this);
+    cancelPendingUpdate();
 }
 
 void WFSMessenger::connect() {
@@ -21,13 +30,40 @@ void WFSMessenger::connect() {
     // TODO: make these specifiable via the UI
     socket->bindToPort(8888, "192.168.10.10");
     // TODO: also make multicast IP and port specifiable via the UI.
-    connectToSocket(*socket, "230.0.0.20", 41814);
+    connectToSocket(*socket, kMulticastIP, kMulticastPort);
+}
+
+OSCTimeTag WFSMessenger::now() {
+    // Time::getCurrentTime() only resolves milliseconds, which would limit how
+    // closely the nodes can estimate their offsets from this clock.
+    auto micros{std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()};
+    // OSC timetags count from 1900, not 1970.
+    constexpr uint64 ntpEpochOffset{2208988800};
+    auto seconds{static_cast<uint64>(micros / 1000000) + ntpEpochOffset};
+    auto fraction{(static_cast<uint64>(micros % 1000000) << 32) / 1000000};
+    return OSCTimeTag{(seconds << 32) | fraction};
 }
 
 void WFSMessenger::valueTreePropertyChanged(ValueTree &treeWhosePropertyHasChanged, const Identifier &property) {
     ignoreUnused(treeWhosePropertyHasChanged);
 
-    OSCBundle bundle;
+    // Positions are gathered, and go out together once the message loop is
+    // done with this pass, so a move (x then y), or several sources' moves,
+    // take a single datagram.
+    auto name{property.toString()};
+    if (name.startsWith("/source/") && (name.endsWith("/x") || name.endsWith("/y"))) {
+        auto source{name.fromFirstOccurrenceOf("/source/", false, false).getIntValue()};
+        if (source >= 0 && source < SceneFrame::kMaxSources) {
+            updateScenePosition(source);
+            triggerAsyncUpdate();
+        }
+        return;
+    }
+
+    // Stamped with the time of sending; the nodes apply the bundle a fixed
+    // latency after that, all at the same moment.
+    OSCBundle bundle{now()};
 
     if (property.toString().contains("module")) {
 //        DBG("Sending OSC: " << property.toString() << " " << valueTree.getProperty(property).toString());
@@ -40,4 +76,33 @@ void WFSMessenger::valueTreePropertyChanged(ValueTree &treeWhosePropertyHasChang
     send(bundle);
 }
 
+void WFSMessenger::updateScenePosition(int source) {
+    // Both co-ordinates from the tree, so a source is only sent once it has
+    // both, and never with the other taken as 0; one removed is no longer
+    // sent at all.
+    Identifier x{"/source/" + String{source} + "/x"}, y{"/source/" + String{source} + "/y"};
+    if (!valueTree.hasProperty(x) || !valueTree.hasProperty(y)) {
+        sceneOut.valid &= ~SceneFrame::bit(source);
+        return;
+    }
+    sceneOut.x[source] = static_cast<float>(valueTree.getProperty(x));
+    sceneOut.y[source] = static_cast<float>(valueTree.getProperty(y));
+    sceneOut.valid |= SceneFrame::bit(source);
+    sceneOut.changed |= SceneFrame::bit(source);
+    sceneOut.numSources = jmax(sceneOut.numSources, source + 1);
+}
 
+void WFSMessenger::handleAsyncUpdate() {
+    if (sceneOut.changed == 0) {
+        return;
+    }
+    // Stamped, as bundles are, with the time of sending.
+    sceneOut.sequence++;
+    sceneOut.timetag = now().getRawTimeTag();
+    uint8 buffer[SceneFrame::kMaxSize];
+    auto size{sceneOut.encode(buffer, sizeof(buffer))};
+    if (size > 0) {
+        socket->write(kMulticastIP, kMulticastPort, buffer, size);
+    }
+    sceneOut.changed = 0;
+}
@@ -6,8 +6,13 @@
 #define JACKTRIP_TEENSY_WFSMESSENGER_H
 
 #include <JuceHeader.h>
+#include "../src/SceneFrame.h"
 
-class WFSMessenger : public OSCSender, public ValueTree::Listener {
+/**
+ * Sends the value tree's properties to the nodes: source positions as scene
+ * frames (see SceneFrame.h), everything else as OSC.
+ */
+class WFSMessenger : public OSCSender, public ValueTree::Listener, private AsyncUpdater {
 public:
     explicit WFSMessenger(ValueTree &tree);
 
@@ -18,7 +23,30 @@ public:
     void valueTreePropertyChanged(ValueTree &treeWhosePropertyHasChanged, const Identifier &property) override;
 
 private:
+    /**
+     * Take a source's position from the value tree, and mark it changed, if
+     * the tree has both its co-ordinates; otherwise, mark it invalid.
+     */
+    void updateScenePosition(int source);
+
+    /**
+     * Send every source's position, in one datagram, flagging those changed
+     * since the last.
+     */
+    void handleAsyncUpdate() override;
+
+    /**
+     * The current time, as an OSC timetag, to the microsecond.
+     */
+    static OSCTimeTag now();
+
+    static constexpr const char *kMulticastIP{"230.0.0.20"};
+    static constexpr int kMulticastPort{41814};
+
     std::unique_ptr<juce::DatagramSocket> socket;
+    // Every source's position, flagging those changed since the last frame
+    // was sent.
+    SceneFrame sceneOut;
     ValueTree &valueTree;
 };
 
@@ -73,10 +73,19 @@ void XYController::createNode(Point<float> position) {
         removeNode(nodeToRemove);
     };
 
+    node->onGainChange = [this](Node *nodeToUpdate) {
+        nodeToUpdate->repaint();
+        notifyGainChange(nodeToUpdate);
+    };
+
     if (onValueChange != nullptr) {
         onValueChange(key, {node->value.x, node->value.y});
     }
 
+    // New nodes start at unity gain, unmuted, whatever the previous occupant
+    // of this index was set to.
+    notifyGainChange(node);
+
     if (onAddNode != nullptr) {
         onAddNode(key);
     }
@@ -98,6 +107,17 @@ void XYController::removeNode(Node *const node) {
     }
 }
 
+void XYController::notifyGainChange(Node *const node) {
+    if (onGainChange != nullptr) {
+        for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+            if (it->second.get() == node) {
+                onGainChange(it->first, node->gain, node->muted);
+                return;
+            }
+        }
+    }
+}
+
 void XYController::removeAllNodes() {
     auto it{nodes.begin()};
     while (it != nodes.end()) {
@@ -135,10 +155,21 @@ XYController::Node::Node(Value val, uint idx) : index(idx), value(val) {}
 void XYController::Node::paint(Graphics &g) {
     auto colour{
             juce::Colours::steelblue.withRotatedHue(static_cast<float>(index) * 1 / juce::MathConstants<float>::twoPi)};
+    if (muted) {
+        colour = colour.withSaturation(0.f).withAlpha(.5f);
+    }
     g.setColour(colour);
     g.fillEllipse(getLocalBounds().toFloat());
     g.setColour(colour.darker(.25));
     g.drawEllipse(getLocalBounds().withSizeKeepingCentre(getWidth() - 2, getHeight() - 2).toFloat(), 2.f);
+    // Show gain as an arc around the node, full circle at MAX_GAIN.
+    Path gainArc;
+    auto arcBounds{getLocalBounds().withSizeKeepingCentre(getWidth() - 8, getHeight() - 8).toFloat()};
+    gainArc.addCentredArc(arcBounds.getCentreX(), arcBounds.getCentreY(),
+                          arcBounds.getWidth() / 2, arcBounds.getHeight() / 2, 0.f,
+                          0.f, MathConstants<float>::twoPi * gain / MAX_GAIN, true);
+    g.setColour(Colours::white.withAlpha(.66f));
+    g.strokePath(gainArc, PathStrokeType(2.f));
     g.setColour(Colours::white);
     g.setFont(20);
     g.drawText(String(index + 1), getLocalBounds(), Justification::centred);
@@ -149,10 +180,21 @@ void XYController::Node::mouseDown(const MouseEvent &event) {
         // Try to remove this node.
         PopupMenu m;
         m.addItem(1, "Remove node");
+        m.addItem(2, "Mute", true, muted);
+        m.addItem(3, "Reset gain", gain != 1.f);
         // TODO: expose possibility of adding more menu items via a callback.
         m.showMenuAsync(PopupMenu::Options(), [this, event](int result) {
             if (result == 1 && onRemove != nullptr) {
                 onRemove(this);
+            } else if (result == 2 || result == 3) {
+                if (result == 2) {
+                    muted = !muted;
+                } else {
+                    gain = 1.f;
+                }
+                if (onGainChange != nullptr) {
+                    onGainChange(this);
+                }
             }
         });
     }
@@ -176,6 +218,14 @@ void XYController::Node::mouseDrag(const MouseEvent &event) {
     }
 }
 
+void XYController::Node::mouseWheelMove(const MouseEvent &event, const MouseWheelDetails &wheel) {
+    ignoreUnused(event);
+    gain = clamp(gain + wheel.deltaY * .25f, 0., MAX_GAIN);
+    if (onGainChange != nullptr) {
+        onGainChange(this);
+    }
+}
+
 float XYController::Node::clamp(float val, float min, float max) {
     if (val >= max) {
         val = max;
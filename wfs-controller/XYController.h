@@ -31,6 +31,8 @@ public:
 
     std::function<void(uint nodeIndex)> onRemoveNode;
 
+    std::function<void(uint nodeIndex, float gain, bool muted)> onGainChange;
+
 protected:
     class Node : public Component {
     private:
@@ -46,18 +48,25 @@ protected:
 
         void mouseDrag(const MouseEvent &event) override;
 
+        void mouseWheelMove(const MouseEvent &event, const MouseWheelDetails &wheel) override;
+
         std::function<void(Node *)> onMove;
 
         std::function<void(Node *)> onRemove;
+
+        std::function<void(Node *)> onGainChange;
     private:
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
 
         void setBounds();
 
         static constexpr float NODE_WIDTH{50.f};
+        static constexpr float MAX_GAIN{2.f};
 
         uint index{0};
         Value value{};
+        float gain{1.f};
+        bool muted{false};
 
         friend class XYController;
 
@@ -75,6 +84,8 @@ private:
 
     void removeNode(Node *node);
 
+    void notifyGainChange(Node *node);
+
     uint getNextAvailableNodeID();
 
     void removeAllNodes();